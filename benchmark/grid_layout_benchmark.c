@@ -0,0 +1,175 @@
+/*
+   File: grid_layout_benchmark.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: Benchmark comparing the memory layouts of the field grids. A floor field of a large empty room is stored with each layout,
+                and the time spent storing it, scanning it line by line and reading the neighborhoods of scattered pedestrians walking
+                towards the exit (the access pattern of find_smallest_cell) is measured.
+                Usage: grid_layout_benchmark.exe [SIDE] [PRECISION] [PEDESTRIANS] [TIMESTEPS]
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<time.h>
+
+#include"../headers/grid.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+static Int_Grid create_room_floor_field(int side);
+static double elapsed_time(struct timespec start);
+
+int main(int argc, char **argv)
+{
+    int side = argc > 1 ? atoi(argv[1]) : 2000;
+    enum Field_Precision precision = argc > 2 ? atoi(argv[2]) : PRECISION_DOUBLE;
+    int num_pedestrians = argc > 3 ? atoi(argv[3]) : 100000;
+    int num_timesteps = argc > 4 ? atoi(argv[4]) : 100;
+
+    if(side < 3 || precision < PRECISION_DOUBLE || precision > PRECISION_FIXED_32 || num_pedestrians <= 0 || num_timesteps <= 0)
+    {
+        fprintf(stderr, "Usage: %s [SIDE] [PRECISION] [PEDESTRIANS] [TIMESTEPS]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    cli_args.global_line_number = side;
+    cli_args.global_column_number = side;
+    cli_args.diagonal_numerator = 3;
+    cli_args.diagonal_denominator = 2;
+
+    Int_Grid room_floor_field = create_room_floor_field(side);
+    Location *positions = malloc(sizeof(Location) * num_pedestrians);
+    if(room_floor_field == NULL || positions == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of the benchmark structures.\n");
+        return EXIT_FAILURE;
+    }
+
+    const char *layout_names[] = {"", "row-major", "tiled", "morton"};
+
+    printf("Grid of %d x %d cells, precision %d, %d pedestrians, %d timesteps.\n", side, side, precision, num_pedestrians, num_timesteps);
+    printf("%-10s %12s %16s %22s %12s\n", "layout", "store (ms)", "scan (ns/cell)", "neighborhood (ns/ped)", "checksum");
+
+    for(enum Grid_Layout layout = LAYOUT_ROW_MAJOR; layout <= LAYOUT_MORTON; layout++)
+    {
+        Field_Grid floor_field = allocate_field_grid(side, side, precision, layout);
+        if(floor_field.cells == NULL)
+            return EXIT_FAILURE;
+
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        if(store_field_grid(floor_field, room_floor_field) == FAILURE)
+            return EXIT_FAILURE;
+        double store_time = elapsed_time(start);
+
+        long long int checksum = 0;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for(int i = 0; i < side; i++)
+        {
+            for(int h = 0; h < side; h++)
+                checksum += get_field_units(floor_field, i, h);
+        }
+        double scan_time = elapsed_time(start);
+
+        // Every layout walks the same pedestrians.
+        srand(0);
+        for(int p_index = 0; p_index < num_pedestrians; p_index++)
+            positions[p_index] = (Location) {1 + rand() % (side - 2), 1 + rand() % (side - 2)};
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for(int timestep = 0; timestep < num_timesteps; timestep++)
+        {
+            for(int p_index = 0; p_index < num_pedestrians; p_index++)
+            {
+                Location current = positions[p_index];
+                Location smallest = current;
+                int smallest_value = get_field_units(floor_field, current.lin, current.col);
+
+                for(int j = -1; j < 2; j++)
+                {
+                    for(int k = -1; k < 2; k++)
+                    {
+                        int value = get_field_units(floor_field, current.lin + j, current.col + k);
+                        if(value < smallest_value) // The walls are WALL_UNITS, above every distance.
+                        {
+                            smallest_value = value;
+                            smallest = (Location) {current.lin + j, current.col + k};
+                        }
+                    }
+                }
+
+                if(smallest.lin == 0) // Reached the exit, so it reappears at the opposite side of the room.
+                    smallest.lin = side - 2;
+
+                positions[p_index] = smallest;
+                checksum += smallest_value;
+            }
+        }
+        double walk_time = elapsed_time(start);
+
+        printf("%-10s %12.2lf %16.3lf %22.3lf %12lld\n", layout_names[layout], store_time * 1e3, scan_time * 1e9 / ((double) side * side),
+                                                           walk_time * 1e9 / ((double) num_pedestrians * num_timesteps), checksum);
+
+        deallocate_field_grid(&floor_field);
+    }
+
+    free(positions);
+    deallocate_grid((void **) room_floor_field, side);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Creates the floor field, in floor field units, of an empty square room with a single exit in the middle of its upper wall.
+ *
+ * @param side Number of lines and columns of the room, including the walls.
+ * @return An Int_Grid with the floor field, or NULL on error.
+ */
+static Int_Grid create_room_floor_field(int side)
+{
+    Int_Grid floor_field = allocate_integer_grid(side, side);
+    if(floor_field == NULL)
+        return NULL;
+
+    int p = cli_args.diagonal_numerator;
+    int q = cli_args.diagonal_denominator;
+    int exit_column = side / 2;
+
+    for(int i = 0; i < side; i++)
+    {
+        for(int h = 0; h < side; h++)
+        {
+            if(i == 0 || h == 0 || i == side - 1 || h == side - 1)
+            {
+                floor_field[i][h] = WALL_UNITS;
+                continue;
+            }
+
+            int vertical = i;
+            int horizontal = abs(h - exit_column);
+            int diagonal_steps = vertical < horizontal ? vertical : horizontal;
+            int straight_steps = abs(vertical - horizontal);
+
+            floor_field[i][h] = EXIT_VALUE * q + diagonal_steps * p + straight_steps * q;
+        }
+    }
+
+    floor_field[0][exit_column] = EXIT_VALUE * q;
+
+    return floor_field;
+}
+
+/**
+ * Determines the time elapsed since the given instant.
+ *
+ * @param start The starting instant.
+ * @return The elapsed time in seconds.
+ */
+static double elapsed_time(struct timespec start)
+{
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
@@ -0,0 +1,8 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include"shared_resources.h"
+
+Function_Status run_batch();
+
+#endif
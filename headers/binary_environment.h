@@ -0,0 +1,37 @@
+#ifndef BINARY_ENVIRONMENT_H
+#define BINARY_ENVIRONMENT_H
+
+#include<stdio.h>
+#include<stdint.h>
+#include<stdbool.h>
+
+#include"shared_resources.h"
+
+#define BINARY_ENVIRONMENT_MAGIC "VARASENV"
+#define BINARY_ENVIRONMENT_VERSION 1
+
+typedef struct{
+    char magic[8]; // BINARY_ENVIRONMENT_MAGIC, without the null terminator.
+    uint32_t version;
+    uint32_t line_number;
+    uint32_t column_number;
+    uint32_t num_wall_runs;
+    uint32_t num_exit_cells;
+    uint32_t num_pedestrians;
+}Binary_Environment_Header;
+
+typedef struct{
+    uint32_t start; // Index of the first cell of the run, counting line after line.
+    uint32_t length; // Number of consecutive walls, which may continue on the following lines.
+}Binary_Wall_Run;
+
+typedef struct{
+    uint32_t lin;
+    uint32_t col;
+}Binary_Location;
+
+bool is_binary_environment(const char *content, size_t size);
+Function_Status load_binary_environment(const char *content, size_t size);
+Function_Status convert_environment(bool to_binary);
+
+#endif
@@ -7,7 +7,7 @@
 
 typedef struct{
     Location coordinates;
-    double value;
+    int value; // Floor field value, in units of 1 / diagonal_denominator.
 }Cell;
 
 typedef struct cell_list{
@@ -15,6 +15,8 @@ typedef struct cell_list{
     Cell *list;
 }cell_list;
 
-Cell find_smallest_cell(Location ped_coordinates, bool unoccupied_only);
+Cell find_smallest_cell(Location ped_coordinates, bool unoccupied_only, int random_number);
+bool has_candidate_cells(Location ped_coordinates, bool unoccupied_only);
+bool is_cell_enclosed(Location ped_coordinates);
 
 #endif
\ No newline at end of file
@@ -11,8 +11,14 @@ typedef struct{
     char environment_filename[150];
     char output_filename[150];
     char auxiliary_filename[150];
+    char converted_environment_filename[150];
+    char batch_filename[150];
+    char merged_shard_filenames[600]; // Comma separated output files of the shards merged by --merge-shards.
+    char sweep_specifications[600]; // Space separated PARAMETER:VALUES given to --sweep, parsed by load_sweep_parameters.
     enum Output_Format output_format;
     enum Environment_Origin environment_origin;
+    enum Field_Precision field_precision;
+    enum Grid_Layout grid_layout;
     bool write_to_file;
     bool show_debug_information;
     bool show_simulation_set_info;
@@ -22,16 +28,36 @@ typedef struct{
     bool allow_X_movement;
     bool single_exit_flag;
     bool varas_fig7;
+    bool combination_with_repetition;
+    bool use_floor_field_cache;
+    bool use_branch_and_bound; // Searches for the best simulation sets by branch and bound on lower bounds of their number of timesteps.
+    bool deduplicate_sets; // Simulates only once the simulation sets with the same exits, replaying their output.
     int global_line_number;
     int global_column_number;
     int num_simulations;
     int total_num_pedestrians;
     int seed;
+    int spatial_sort_interval; // Timesteps between spatial sortings of the pedestrians, where 0 disables them.
+    int pgm_thresholds[3]; // Gray levels separating walls, exits, pedestrians and empty cells in PGM images.
+    int pgm_downsample_factor; // Pixels of a PGM image, in each direction, represented by a single cell.
+    int num_threads; // Threads used to calculate and merge the floor fields.
+    int pipeline_depth; // Simulation sets prepared ahead of the simulations, where 0 disables the pipeline.
+    int max_timesteps; // Timesteps after which a simulation is interrupted, where 0 disables the limit.
+    int stall_limit; // Consecutive timesteps without progress after which a simulation is interrupted, where 0 disables the limit.
+    double ci_half_width; // Target half-width of the confidence interval of the mean number of timesteps, where 0 disables the adaptive number of simulations.
+    int min_simulations; // Minimum number of simulations of each simulation set when the number of simulations is adaptive.
+    int successive_halving_rounds; // Rounds of the search for the best simulation sets, where 0 disables the search.
+    int exit_combination_size; // Number of exits combined in each simulation set, where 0 uses the simulation sets of the auxiliary file.
     double diagonal;
+    int shard_index; // Shard whose simulation sets are run, among num_shards.
+    int num_shards; // Number of shards among which the simulation sets are split, where 0 disables the sharding.
+    int diagonal_numerator; // The diagonal value as the fraction diagonal_numerator / diagonal_denominator.
+    int diagonal_denominator;
 } Command_Line_Args;
 
 error_t parser_function(int key, char *arg, struct argp_state *state);
 void extract_full_command(char *full_command, int key, char *arg);
+Function_Status extract_diagonal_fraction(const char *diagonal_text, int *numerator, int *denominator);
 
 extern Command_Line_Args cli_args; // cli stands for command line interface
 extern const char * argp_program_version;
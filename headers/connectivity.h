@@ -0,0 +1,12 @@
+#ifndef CONNECTIVITY_H
+#define CONNECTIVITY_H
+
+#include"exit.h"
+#include"shared_resources.h"
+
+Function_Status label_environment_components();
+Function_Status verify_simulation_set_connectivity();
+void get_exit_region(Exit current_exit, Location *first_cell, Location *last_cell);
+void deallocate_environment_components();
+
+#endif
@@ -1,18 +1,21 @@
 #ifndef EXIT_H
 #define EXIT_H
 
+#include<stdbool.h>
+
 #include"shared_resources.h"
 #include"grid.h"
 
 struct exit {
     int width; // in contiguous cells
     Location *coordinates; // cells that form up the exit
-    Double_Grid floor_field;
+    Field_Grid floor_field;
+    bool is_floor_field_cached; // The floor field belongs to the floor field cache and isn't deallocated with the exit.
 };
 typedef struct exit * Exit;
 
 typedef struct{
-    Double_Grid final_floor_field; // Floor field obtained by combining the floor fields of each door
+    Field_Grid final_floor_field; // Floor field obtained by combining the floor fields of each door
     Exit *list;
     int num_exits;
 } Exits_Set;
@@ -20,8 +23,12 @@ typedef struct{
 Function_Status add_new_exit(Location exit_coordinates);
 Function_Status expand_exit(Exit original_exit, Location new_coordinates);
 Function_Status calculate_final_floor_field();
+double estimate_final_floor_field_seconds();
+bool is_exit_accessible(Exit current_exit);
 void deallocate_exits();
+void deallocate_floor_fields();
+void deallocate_floor_field_cache();
 
-extern Exits_Set exits_set;
+extern _Thread_local Exits_Set exits_set; // Each thread has its own, so that simulation sets may be prepared in the background.
 
 #endif
@@ -1,25 +1,59 @@
 #ifndef GRID_H
 #define GRID_H
 
+#include<limits.h>
+#include<stdint.h>
 #include<stdbool.h>
 
 #include"shared_resources.h"
 
+#define BITS_PER_WORD 64
+#define TILE_SIDE_BITS 3 // Tiles of the tiled layout have 2^3 x 2^3 cells.
+#define LARGE_PAGE_SIZE (2 * 1024 * 1024) // Field grids of at least this size are mapped with large pages, when available.
+#define WALL_UNITS INT_MAX // Walls and obstacles of the integer floor fields, above every distance (see verify_field_units_range).
+
 typedef int ** Int_Grid;
 typedef double ** Double_Grid;
+typedef uint64_t ** Bit_Grid; // Each cell is represented by a single bit.
+
+typedef struct{
+    enum Field_Precision precision; // How each cell is stored.
+    enum Grid_Layout layout; // How the cells are ordered in memory.
+    int tiles_per_line; // Number of tiles covering the columns of the grid (tiled layout).
+    int interleaved_bits; // Number of bits of each coordinate that are interleaved (Morton layout).
+    size_t mapped_size; // Size of the memory mapping holding the cells, or 0 if they were allocated with calloc.
+    void *cells; // All cells of the grid, ordered according to the layout.
+}Field_Grid;
 
 Int_Grid allocate_integer_grid(int line_number, int column_number);
 Double_Grid allocate_double_grid(int line_number, int column_number);
+Bit_Grid allocate_bit_grid(int line_number, int column_number);
+Field_Grid allocate_field_grid(int line_number, int column_number, enum Field_Precision precision, enum Grid_Layout layout);
 Function_Status reset_integer_grid(Int_Grid integer_grid, int line_number, int column_number);
 Function_Status reset_double_grid(Double_Grid double_grid, int line_number, int column_number);
+Function_Status reset_bit_grid(Bit_Grid bit_grid, int line_number, int column_number);
+Function_Status copy_integer_grid(Int_Grid destination, Int_Grid source);
 Function_Status copy_double_grid(Double_Grid destination, Double_Grid source);
-bool is_diagonal_valid(Location origin_cell, Location target_cell, Double_Grid floor_field);
+Function_Status store_field_grid(Field_Grid destination, Int_Grid source);
+Function_Status store_field_lines(Field_Grid destination, Int_Grid source, int first_line, int end_line);
+bool is_field_wall(Field_Grid field_grid, int line, int column);
+double get_field_value(Field_Grid field_grid, int line, int column);
+int get_field_units(Field_Grid field_grid, int line, int column);
+Function_Status verify_field_units_range();
+uint64_t calculate_morton_code(int line, int column);
+bool is_diagonal_valid(Location origin_cell, Location target_cell, Int_Grid floor_field);
+void set_grid_bit(Bit_Grid bit_grid, Location cell);
+bool is_grid_bit_set(Bit_Grid bit_grid, Location cell);
+unsigned int get_bit_neighborhood(Bit_Grid bit_grid, Location center, bool outside_value);
 bool is_within_grid_lines(int line_coordinate);
 bool is_within_grid_columns(int column_coordinate);
 void deallocate_grid(void **grid, int line_number);
+void deallocate_field_grid(Field_Grid *field_grid);
 
 extern Int_Grid environment_only_grid;
 extern Int_Grid pedestrian_position_grid;
 extern Int_Grid heatmap_grid;
+extern Bit_Grid occupancy_bitmap;
+extern _Thread_local Bit_Grid wall_bitmap; // Belongs to the exits_set of each thread.
 
 #endif
\ No newline at end of file
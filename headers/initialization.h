@@ -1,6 +1,9 @@
 #ifndef INITIALIZATION_H
 #define INITIALIZATION_H
 
+#include<stdio.h>
+#include<stdbool.h>
+
 #include"shared_resources.h"
 
 Function_Status open_auxiliary_file(FILE **auxiliary_file);
@@ -8,7 +11,9 @@ Function_Status open_output_file(FILE **output_file);
 Function_Status allocate_grids();
 Function_Status load_environment();
 Function_Status generate_environment();
-int extract_simulation_set_quantity(FILE *auxiliary_file);
-Function_Status get_next_simulation_set(FILE *auxiliary_file, int *exit_number);
+
+extern const char *environment_path;
+extern const char *output_path;
+extern bool environment_file_is_binary;
 
 #endif
\ No newline at end of file
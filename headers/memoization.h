@@ -0,0 +1,15 @@
+#ifndef MEMOIZATION_H
+#define MEMOIZATION_H
+
+#include<stdio.h>
+
+#include"shared_resources.h"
+
+typedef struct memoized_set * Memoized_Set;
+
+Function_Status find_memoized_simulation_set(Memoized_Set *memoized_set);
+Function_Status memoize_simulation_set(char *output, size_t output_size, Function_Status status);
+Function_Status replay_memoized_simulation_set(Memoized_Set memoized_set, FILE *output_file);
+void deallocate_memoized_simulation_sets();
+
+#endif
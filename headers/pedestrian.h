@@ -14,12 +14,15 @@ struct pedestrian {
     Location origin; // Original pedestrian localization. Remains unchanged until the structure instance is deallocated.
     Location current; 
     Location target;
+    int random_number; // Drawn in the ID order for the movement of the current timestep, when the list is spatially sorted.
 };
 typedef struct pedestrian * Pedestrian;
 
 typedef struct{
-    Pedestrian *list;
+    Pedestrian *list; // Order in which the pedestrians are processed, which may be spatially sorted.
+    Pedestrian *by_id; // Pedestrians indexed by their ID - 1, which never changes.
     int num_pedestrians;
+    int num_stalled_timesteps; // Consecutive timesteps in which no pedestrian moved or left the environment.
 } Pedestrian_Set;
 
 Function_Status insert_pedestrians_at_random(int qtd);
@@ -34,9 +37,12 @@ void block_X_movement();
 void apply_pedestrian_movement();
 void update_pedestrian_position_grid();
 bool is_environment_empty();
+bool is_environment_deadlocked();
 void reset_pedestrian_state();
 void reset_pedestrian_panic();
 void reset_pedestrians_structures();
+void count_pedestrians_in_heatmap();
+Function_Status sort_pedestrians_spatially();
 
 extern Pedestrian_Set pedestrian_set;
 
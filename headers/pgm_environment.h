@@ -0,0 +1,10 @@
+#ifndef PGM_ENVIRONMENT_H
+#define PGM_ENVIRONMENT_H
+
+#include<stdio.h>
+
+#include"shared_resources.h"
+
+Function_Status load_pgm_environment(const char *content, size_t size);
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include"shared_resources.h"
+
+Function_Status start_simulation_set_pipeline(int num_sets, int depth);
+Function_Status take_prepared_simulation_set();
+void stop_simulation_set_pipeline();
+
+#endif
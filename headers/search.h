@@ -0,0 +1,11 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include<stdio.h>
+
+#include"shared_resources.h"
+
+Function_Status run_successive_halving(FILE *output_file, int num_sets);
+Function_Status run_branch_and_bound(FILE *output_file, int num_sets);
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef SHARD_H
+#define SHARD_H
+
+#include<stdio.h>
+#include<stdbool.h>
+
+#include"shared_resources.h"
+
+bool is_set_in_shard(int set_index);
+void print_shard_set_marker(FILE *output_file, int set_index);
+Function_Status merge_shard_files(FILE *output_file);
+
+#endif
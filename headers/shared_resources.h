@@ -9,19 +9,34 @@ enum Output_Format {
     OUTPUT_HEATMAP
 };
 
+enum Field_Precision {
+    PRECISION_DOUBLE = 1, 
+    PRECISION_FLOAT, 
+    PRECISION_FIXED_16, 
+    PRECISION_FIXED_32
+};
+
+enum Grid_Layout {
+    LAYOUT_ROW_MAJOR = 1, 
+    LAYOUT_TILED, 
+    LAYOUT_MORTON
+};
+
 enum Environment_Origin {
     ONLY_STRUCTURE = 1, 
     STRUCTURE_AND_DOORS, 
     STRUCTURE_AND_PEDESTRIANS, 
     STRUCTURE_DOORS_AND_PEDESTRIANS, 
-    AUTOMATIC_CREATED
+    AUTOMATIC_CREATED, 
+    PGM_IMAGE
 };
 
 typedef enum Function_Status {
     FAILURE = 0, 
     END_PROGRAM = 0,
     SUCCESS = 1, 
-    INACCESSIBLE_EXIT = 2
+    INACCESSIBLE_EXIT = 2,
+    UNREACHABLE_PEDESTRIANS = 3 // Some pedestrians are in a region of the environment without exits.
 }Function_Status;
 
 typedef struct{
@@ -31,6 +46,7 @@ typedef struct{
 
 #define EXIT_VALUE 1
 #define WALL_VALUE 1000
+#define INTERRUPTED_SIMULATION -2 // Number of timesteps reported for simulations interrupted by a deadlock, a stall or the timestep limit.
 
 bool origin_uses_auxiliary_data();
 bool origin_uses_static_pedestrians();
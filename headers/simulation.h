@@ -0,0 +1,13 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include<stdio.h>
+
+#include"statistics.h"
+#include"shared_resources.h"
+
+Function_Status run_requested_simulations(FILE *output_file, int num_sets);
+Function_Status run_simulation_sets(FILE *output_file, int num_sets);
+Function_Status run_simulations(FILE *output_file, int num_simulations, Sample_Statistics *statistics, int *num_simulations_run);
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef SIMULATION_SET_H
+#define SIMULATION_SET_H
+
+#include<stdio.h>
+#include<stddef.h>
+
+#include"shared_resources.h"
+
+typedef struct{
+    Location *cells; // Coordinates of the cells of every exit, exit after exit.
+    size_t *exit_starts; // Index, in cells, of the first cell of each exit. Has num_exits + 1 positions.
+    size_t *set_starts; // Index, in exit_starts, of the first exit of each simulation set. Has num_sets + 1 positions.
+    size_t *candidate_exits; // Index, in exit_starts, of each distinct exit combined by --combine-exits.
+    size_t num_cells;
+    size_t num_exits;
+    int num_candidates;
+    int num_sets; // With --combine-exits, the number of combinations instead of the number of simulation sets in the file.
+}Simulation_Set_Index;
+
+Function_Status load_simulation_set_index(FILE *auxiliary_file);
+Function_Status load_simulation_set(int set_index);
+void deallocate_simulation_set_index();
+
+extern Simulation_Set_Index simulation_sets;
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+typedef struct{
+    int num_samples;
+    double mean;
+    double sum_squared_deviations; // Sum of the squared deviations from the mean, updated with Welford's algorithm.
+}Sample_Statistics;
+
+void add_sample(Sample_Statistics *statistics, double value);
+double calculate_standard_deviation(Sample_Statistics statistics);
+double calculate_confidence_half_width(Sample_Statistics statistics);
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include<stdio.h>
+#include<stdbool.h>
+
+#include"shared_resources.h"
+
+Function_Status load_sweep_parameters();
+bool is_sweep_active();
+Function_Status run_sweep(FILE *output_file, int num_sets);
+void deallocate_sweep_parameters();
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include<stdbool.h>
+
+#include"shared_resources.h"
+
+typedef void (*Parallel_Task)(void *task_data, int task_index);
+
+Function_Status create_thread_pool(int num_threads);
+void run_parallel_tasks(Parallel_Task task, void *task_data, int num_tasks);
+bool is_thread_pool_active();
+int get_thread_pool_size();
+void destroy_thread_pool();
+
+#endif
@@ -0,0 +1,313 @@
+/*
+   File: batch.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-19
+   Description: This module runs the batch files, which list several executions of the program, one per line, with the same options
+                given in the command line. The runs are executed one after another in the same process: an environment is only
+                loaded again when a run uses a different one, and the floor fields of the exits are kept in the floor field cache
+                while the environment and the parameters they depend on remain the same.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<stdbool.h>
+#include<argp.h>
+
+#include"../headers/grid.h"
+#include"../headers/exit.h"
+#include"../headers/batch.h"
+#include"../headers/sweep.h"
+#include"../headers/pedestrian.h"
+#include"../headers/simulation.h"
+#include"../headers/thread_pool.h"
+#include"../headers/connectivity.h"
+#include"../headers/simulation_set.h"
+#include"../headers/initialization.h"
+#include"../headers/cli_processing.h"
+#include"../headers/binary_environment.h"
+#include"../headers/printing_utilities.h"
+#include"../headers/shared_resources.h"
+
+#define MAX_BATCH_LINE_LENGTH 1000
+#define MAX_RUN_ARGUMENTS 100
+
+static Command_Line_Args loaded_arguments; // Arguments of the last run, whose environment and floor field cache are kept.
+static bool is_environment_loaded = false;
+
+static Function_Status run_batch_line(char *line, int line_number, Command_Line_Args default_arguments);
+static Function_Status prepare_run_environment();
+static Function_Status run_batch_simulations(FILE *output_file, FILE *auxiliary_file);
+static bool has_same_environment(Command_Line_Args *first, Command_Line_Args *second);
+static bool has_same_floor_fields(Command_Line_Args *first, Command_Line_Args *second);
+static void deallocate_environment();
+
+/**
+ * Runs every execution listed in the batch file given with --batch, in order. Each non-empty line that doesn't start with # holds
+ * the options of an execution, as they would be given in the command line.
+ *
+ * @note The other options given with --batch are shared by every run, which may override them. The batch is stopped at the first
+ * run that fails.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status run_batch()
+{
+    Command_Line_Args default_arguments = cli_args;
+    strcpy(default_arguments.batch_filename, "");
+
+    FILE *batch_file = fopen(cli_args.batch_filename, "r");
+    if(batch_file == NULL)
+    {
+        fprintf(stderr, "It was not possible to open the batch file: %s.\n", cli_args.batch_filename);
+        return FAILURE;
+    }
+
+    if(create_thread_pool(cli_args.num_threads) == FAILURE)
+    {
+        fclose(batch_file);
+        return FAILURE;
+    }
+
+    char line[MAX_BATCH_LINE_LENGTH + 2];
+    Function_Status returned_status = SUCCESS;
+    for(int line_number = 1; returned_status == SUCCESS && fgets(line, sizeof(line), batch_file) != NULL; line_number++)
+    {
+        if(strchr(line, '\n') == NULL && ! feof(batch_file))
+        {
+            fprintf(stderr, "The line %d of the batch file is longer than %d characters.\n", line_number, MAX_BATCH_LINE_LENGTH);
+            returned_status = FAILURE;
+            break;
+        }
+
+        returned_status = run_batch_line(line, line_number, default_arguments);
+        if(returned_status == FAILURE)
+            fprintf(stderr, "The run in the line %d of the batch file failed.\n", line_number);
+    }
+
+    fclose(batch_file);
+    deallocate_environment(); // With the dimensions it was loaded with, which the arguments of a failed run may not have.
+
+    return returned_status;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Parses the options of a line of the batch file and runs the execution they describe.
+ *
+ * @param line The line, which is split into the options.
+ * @param line_number Number of the line, starting at 1.
+ * @param default_arguments The shared options, which each run starts from.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1). Empty lines and comments are successful.
+*/
+static Function_Status run_batch_line(char *line, int line_number, Command_Line_Args default_arguments)
+{
+    char *run_argv[MAX_RUN_ARGUMENTS + 1] = {"varas.exe"};
+    int run_argc = 1;
+
+    char *save_pointer = NULL;
+    for(char *token = strtok_r(line, " \t\r\n", &save_pointer); token != NULL; token = strtok_r(NULL, " \t\r\n", &save_pointer))
+    {
+        if(run_argc == 1 && token[0] == '#')
+            return SUCCESS; // Comment.
+
+        if(run_argc == MAX_RUN_ARGUMENTS)
+        {
+            fprintf(stderr, "The line %d of the batch file has more than %d options.\n", line_number, MAX_RUN_ARGUMENTS - 1);
+            return FAILURE;
+        }
+
+        run_argv[run_argc++] = token;
+    }
+
+    if(run_argc == 1)
+        return SUCCESS; // Empty line.
+
+    cli_args = default_arguments;
+
+    if(argp_parse(&argp, run_argc, run_argv, ARGP_NO_EXIT, 0, &cli_args) != 0)
+        return FAILURE;
+
+    if(load_sweep_parameters() == FAILURE) // Replaces the sweep of the previous run.
+        return FAILURE;
+
+    if(strcmp(cli_args.batch_filename, "") != 0 || strcmp(cli_args.merged_shard_filenames, "") != 0)
+    {
+        fprintf(stderr, "--batch and --merge-shards can't be used in a batch file.\n");
+        return FAILURE;
+    }
+
+    cli_args.use_floor_field_cache = true; // The floor fields are shared by the runs.
+
+    FILE *auxiliary_file = NULL;
+    FILE *output_file = NULL;
+    if(open_auxiliary_file(&auxiliary_file) == FAILURE)
+        return FAILURE;
+
+    if(open_output_file(&output_file) == FAILURE)
+    {
+        if(auxiliary_file != NULL)
+            fclose(auxiliary_file);
+        return FAILURE;
+    }
+
+    Function_Status returned_status = prepare_run_environment();
+
+    if(returned_status == SUCCESS && strcmp(cli_args.converted_environment_filename, "") != 0)
+        returned_status = convert_environment(! environment_file_is_binary);
+    else if(returned_status == SUCCESS)
+        returned_status = run_batch_simulations(output_file, auxiliary_file);
+
+    if(auxiliary_file != NULL)
+        fclose(auxiliary_file);
+
+    if(output_file != NULL && output_file != stdout)
+        fclose(output_file);
+
+    deallocate_simulation_set_index();
+    deallocate_environment_components();
+
+    loaded_arguments = cli_args; // Includes the parameters of the floor fields left in the cache, which a sweep may change.
+
+    return returned_status;
+}
+
+/**
+ * Loads the environment of the current run, or reuses the environment of the previous run when they are the same. Reused
+ * floor fields are discarded when the parameters they depend on change.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status prepare_run_environment()
+{
+    if(is_environment_loaded && has_same_environment(&cli_args, &loaded_arguments))
+    {
+        cli_args.global_line_number = loaded_arguments.global_line_number;
+        cli_args.global_column_number = loaded_arguments.global_column_number;
+
+        deallocate_floor_fields(); // The static exits are kept, but their floor fields are obtained again.
+
+        if(! has_same_floor_fields(&cli_args, &loaded_arguments))
+            deallocate_floor_field_cache();
+
+        // The previous run may have left visits in the heatmap, such as when its output wasn't a heatmap.
+        if(reset_integer_grid(heatmap_grid, cli_args.global_line_number, cli_args.global_column_number) == FAILURE)
+            return FAILURE;
+
+        if(origin_uses_static_pedestrians() == true)
+            count_pedestrians_in_heatmap(); // As when they were loaded.
+
+        return SUCCESS;
+    }
+
+    deallocate_environment();
+
+    Function_Status returned_status = cli_args.environment_origin != AUTOMATIC_CREATED ? load_environment() : generate_environment();
+    is_environment_loaded = returned_status == SUCCESS;
+    if(is_environment_loaded)
+        loaded_arguments = cli_args;
+
+    return returned_status;
+}
+
+/**
+ * Runs the simulations of the current run, whose environment is already loaded.
+ *
+ * @param output_file Stream where the output data will be written.
+ * @param auxiliary_file The auxiliary file of the run, or NULL if it isn't used.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status run_batch_simulations(FILE *output_file, FILE *auxiliary_file)
+{
+    int simulation_set_quantity = 1; // Origins that use static exits have a single simulation set.
+
+    print_full_command(output_file);
+
+    if(get_thread_pool_size() != cli_args.num_threads)
+    {
+        destroy_thread_pool();
+        if(create_thread_pool(cli_args.num_threads) == FAILURE)
+            return FAILURE;
+    }
+
+    if(label_environment_components() == FAILURE)
+        return FAILURE;
+
+    if(auxiliary_file != NULL)
+    {
+        if(load_simulation_set_index(auxiliary_file) == FAILURE)
+            return FAILURE;
+
+        simulation_set_quantity = simulation_sets.num_sets;
+    }
+
+    return run_requested_simulations(output_file, simulation_set_quantity);
+}
+
+/**
+ * Verifies if two runs load the same environment.
+ *
+ * @param first Arguments of the first run.
+ * @param second Arguments of the second run.
+ * @return bool, where True indicates that the environments are the same and False otherwise.
+*/
+static bool has_same_environment(Command_Line_Args *first, Command_Line_Args *second)
+{
+    if(first->environment_origin != second->environment_origin)
+        return false;
+
+    if(first->environment_origin == AUTOMATIC_CREATED)
+        return first->global_line_number == second->global_line_number && first->global_column_number == second->global_column_number;
+
+    if(first->environment_origin == PGM_IMAGE && (memcmp(first->pgm_thresholds, second->pgm_thresholds, sizeof(first->pgm_thresholds)) != 0 ||
+                                                  first->pgm_downsample_factor != second->pgm_downsample_factor))
+        return false;
+
+    return strcmp(first->environment_filename, second->environment_filename) == 0;
+}
+
+/**
+ * Verifies if the floor fields calculated by two runs in the same environment are the same.
+ *
+ * @param first Arguments of the first run.
+ * @param second Arguments of the second run.
+ * @return bool, where True indicates that the floor fields are the same and False otherwise.
+*/
+static bool has_same_floor_fields(Command_Line_Args *first, Command_Line_Args *second)
+{
+    return first->diagonal_numerator == second->diagonal_numerator && first->diagonal_denominator == second->diagonal_denominator &&
+           first->prevent_corner_crossing == second->prevent_corner_crossing && first->field_precision == second->field_precision &&
+           first->grid_layout == second->grid_layout;
+}
+
+/**
+ * Deallocates the environment of the previous run, with its pedestrians, exits and cached floor fields.
+*/
+static void deallocate_environment()
+{
+    if(! is_environment_loaded)
+        return;
+
+    int line_number = loaded_arguments.global_line_number;
+
+    deallocate_pedestrians();
+    deallocate_exits();
+    deallocate_floor_field_cache();
+
+    deallocate_grid((void **) environment_only_grid, line_number);
+    deallocate_grid((void **) pedestrian_position_grid, line_number);
+    deallocate_grid((void **) heatmap_grid, line_number);
+    deallocate_grid((void **) occupancy_bitmap, line_number);
+    deallocate_grid((void **) wall_bitmap, line_number);
+
+    environment_only_grid = NULL;
+    pedestrian_position_grid = NULL;
+    heatmap_grid = NULL;
+    occupancy_bitmap = NULL;
+    wall_bitmap = NULL;
+
+    is_environment_loaded = false;
+}
@@ -0,0 +1,367 @@
+/*
+   File: binary_environment.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module implements the binary environment format, along with the conversion between it and the text format. A binary
+                environment file contains a header with its dimensions, the walls and obstacles as runs of consecutive cells, and the lists
+                of exit and pedestrian cells. Every field is an unsigned 32 bits integer in the byte order of the machine that wrote the file.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<stdint.h>
+#include<stdbool.h>
+#include<limits.h>
+
+#include"../headers/grid.h"
+#include"../headers/exit.h"
+#include"../headers/pedestrian.h"
+#include"../headers/initialization.h"
+#include"../headers/cli_processing.h"
+#include"../headers/binary_environment.h"
+#include"../headers/shared_resources.h"
+
+static bool is_binary_location_valid(Binary_Location location);
+static Function_Status load_wall_runs(const Binary_Wall_Run *wall_runs, uint32_t num_wall_runs);
+static Function_Status write_binary_environment(FILE *environment_file);
+static Function_Status write_text_environment(FILE *environment_file);
+
+/**
+ * Verifies if the content of an environment file begins with the binary environment magic bytes.
+ *
+ * @param content Content of the environment file.
+ * @param size Size, in bytes, of the content.
+ * @return bool, where True indicates that the file is a binary environment and False otherwise.
+*/
+bool is_binary_environment(const char *content, size_t size)
+{
+    return size >= strlen(BINARY_ENVIRONMENT_MAGIC) && memcmp(content, BINARY_ENVIRONMENT_MAGIC, strlen(BINARY_ENVIRONMENT_MAGIC)) == 0;
+}
+
+/**
+ * Loads the environment from the content of a binary environment file. The walls, exits and pedestrians are read
+ * directly from the content, without parsing the cells one by one: each wall run is copied into the environment_only_grid
+ * with memcpy, and the empty cells aren't written at all.
+ *
+ * @note The grids are still allocated, zeroed by calloc, for every cell of the environment, so that part of the loading
+ * time depends on the number of cells.
+ *
+ * @note As in the text format, exit cells are walls in the environment_only_grid and static exits and pedestrians are only
+ * added if the environment origin uses them.
+ *
+ * @param content Content of the binary environment file. Must be aligned to 4 bytes, as memory-mapped files are.
+ * @param size Size, in bytes, of the content.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status load_binary_environment(const char *content, size_t size)
+{
+    if(size < sizeof(Binary_Environment_Header))
+    {
+        fprintf(stderr, "The binary environment file is too short to contain its header.\n");
+        return FAILURE;
+    }
+
+    const Binary_Environment_Header *header = (const Binary_Environment_Header *) content;
+    if(header->version != BINARY_ENVIRONMENT_VERSION)
+    {
+        fprintf(stderr, "Unsupported binary environment version: %u.\n", header->version);
+        return FAILURE;
+    }
+
+    if(header->line_number == 0 || header->column_number == 0 || header->line_number > INT_MAX || header->column_number > INT_MAX ||
+       (uint64_t) header->line_number * header->column_number > UINT32_MAX)
+    {
+        fprintf(stderr, "Invalid environment dimensions in the binary environment file: %u x %u.\n", header->line_number, header->column_number);
+        return FAILURE;
+    }
+
+    uint64_t expected_size = sizeof(Binary_Environment_Header) + (uint64_t) header->num_wall_runs * sizeof(Binary_Wall_Run) +
+                             ((uint64_t) header->num_exit_cells + header->num_pedestrians) * sizeof(Binary_Location);
+    if(expected_size != size)
+    {
+        fprintf(stderr, "The size of the binary environment file doesn't match the content described by its header.\n");
+        return FAILURE;
+    }
+
+    cli_args.global_line_number = header->line_number;
+    cli_args.global_column_number = header->column_number;
+
+    if(allocate_grids() == FAILURE) // Freshly allocated grids are already empty, so they aren't reset.
+        return FAILURE;
+
+    const Binary_Wall_Run *wall_runs = (const Binary_Wall_Run *) (content + sizeof(Binary_Environment_Header));
+    const Binary_Location *exit_cells = (const Binary_Location *) (wall_runs + header->num_wall_runs);
+    const Binary_Location *pedestrian_cells = exit_cells + header->num_exit_cells;
+
+    if(load_wall_runs(wall_runs, header->num_wall_runs) == FAILURE)
+        return FAILURE;
+
+    for(uint32_t exit_index = 0; exit_index < header->num_exit_cells; exit_index++)
+    {
+        if(! is_binary_location_valid(exit_cells[exit_index]))
+        {
+            fprintf(stderr, "The exit cell %u is outside the environment.\n", exit_index);
+            return FAILURE;
+        }
+
+        Location coordinates = {exit_cells[exit_index].lin, exit_cells[exit_index].col};
+        if(origin_uses_static_exits() == true)
+        {
+            if(add_new_exit(coordinates) == FAILURE)
+                return FAILURE;
+        }
+
+        environment_only_grid[coordinates.lin][coordinates.col] = WALL_VALUE;
+    }
+
+    for(uint32_t p_index = 0; p_index < header->num_pedestrians; p_index++)
+    {
+        if(! is_binary_location_valid(pedestrian_cells[p_index]))
+        {
+            fprintf(stderr, "The pedestrian %u is outside the environment.\n", p_index + 1);
+            return FAILURE;
+        }
+
+        Location coordinates = {pedestrian_cells[p_index].lin, pedestrian_cells[p_index].col};
+        if(origin_uses_static_pedestrians() == true)
+        {
+            if( add_new_pedestrian(coordinates) == FAILURE)
+                return FAILURE;
+
+            pedestrian_position_grid[coordinates.lin][coordinates.col] = pedestrian_set.list[pedestrian_set.num_pedestrians - 1]->id;
+            set_grid_bit(occupancy_bitmap, coordinates);
+        }
+
+        environment_only_grid[coordinates.lin][coordinates.col] = 0;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Writes the loaded environment, including its static exits and pedestrians, to the file provided by the --convert-env option.
+ *
+ * @param to_binary Whether the environment will be written in the binary format (True) or in the text format (False).
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status convert_environment(bool to_binary)
+{
+    char complete_path[300] = "";
+    sprintf(complete_path,"%s%s",environment_path,cli_args.converted_environment_filename);
+
+    FILE *environment_file = fopen(complete_path, to_binary ? "wb" : "w");
+    if(environment_file == NULL)
+    {
+        fprintf(stderr,"It was not possible to create the converted environment file: %s.\n",cli_args.converted_environment_filename);
+        return FAILURE;
+    }
+
+    Function_Status returned_status = to_binary ? write_binary_environment(environment_file) : write_text_environment(environment_file);
+
+    if(fclose(environment_file) != 0 || returned_status == FAILURE)
+    {
+        fprintf(stderr,"Failure while writing the converted environment file: %s.\n",cli_args.converted_environment_filename);
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Verifies if a location read from a binary environment file is within the environment.
+ *
+ * @param location The location.
+ * @return bool, where True indicates that the location is within the environment and False otherwise.
+*/
+static bool is_binary_location_valid(Binary_Location location)
+{
+    return location.lin < (uint32_t) cli_args.global_line_number && location.col < (uint32_t) cli_args.global_column_number;
+}
+
+/**
+ * Marks the cells of the wall runs of a binary environment file as walls in the environment_only_grid. Each run is copied,
+ * one line at a time, from a line filled with walls.
+ *
+ * @param wall_runs The wall runs, as stored in the file.
+ * @param num_wall_runs Number of wall runs.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status load_wall_runs(const Binary_Wall_Run *wall_runs, uint32_t num_wall_runs)
+{
+    uint64_t num_cells = (uint64_t) cli_args.global_line_number * cli_args.global_column_number;
+
+    int *wall_line = malloc(sizeof(int) * cli_args.global_column_number);
+    if(wall_line == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of the walls of the binary environment.\n");
+        return FAILURE;
+    }
+
+    for(int h = 0; h < cli_args.global_column_number; h++)
+        wall_line[h] = WALL_VALUE;
+
+    for(uint32_t run_index = 0; run_index < num_wall_runs; run_index++)
+    {
+        Binary_Wall_Run current_run = wall_runs[run_index];
+        if((uint64_t) current_run.start + current_run.length > num_cells)
+        {
+            fprintf(stderr, "The wall run %u exceeds the environment dimensions.\n", run_index);
+            free(wall_line);
+            return FAILURE;
+        }
+
+        int line = current_run.start / cli_args.global_column_number;
+        int column = current_run.start % cli_args.global_column_number;
+        uint32_t remaining_length = current_run.length;
+
+        while(remaining_length > 0)
+        {
+            uint32_t line_length = cli_args.global_column_number - column;
+            if(line_length > remaining_length)
+                line_length = remaining_length;
+
+            memcpy(&environment_only_grid[line][column], wall_line, sizeof(int) * line_length);
+
+            remaining_length -= line_length;
+            line++;
+            column = 0;
+        }
+    }
+
+    free(wall_line);
+
+    return SUCCESS;
+}
+
+/**
+ * Writes the loaded environment in the binary format. The header is written again at the end, once the number of wall runs is known.
+ *
+ * @param environment_file File where the environment will be written.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status write_binary_environment(FILE *environment_file)
+{
+    if((uint64_t) cli_args.global_line_number * cli_args.global_column_number > UINT32_MAX)
+    {
+        fprintf(stderr, "The environment is too large for the binary format.\n");
+        return FAILURE;
+    }
+
+    Binary_Environment_Header header = {.version = BINARY_ENVIRONMENT_VERSION, .line_number = cli_args.global_line_number,
+                                        .column_number = cli_args.global_column_number};
+    memcpy(header.magic, BINARY_ENVIRONMENT_MAGIC, sizeof(header.magic));
+
+    if(fwrite(&header, sizeof(header), 1, environment_file) != 1)
+        return FAILURE;
+
+    Binary_Wall_Run current_run = {0, 0};
+    for(int i = 0; i < cli_args.global_line_number; i++)
+    {
+        for(int h = 0; h < cli_args.global_column_number; h++)
+        {
+            if(environment_only_grid[i][h] == WALL_VALUE)
+            {
+                if(current_run.length == 0)
+                    current_run.start = (uint32_t) i * cli_args.global_column_number + h;
+                current_run.length++;
+                continue;
+            }
+
+            if(current_run.length > 0)
+            {
+                if(fwrite(&current_run, sizeof(current_run), 1, environment_file) != 1)
+                    return FAILURE;
+                header.num_wall_runs++;
+                current_run.length = 0;
+            }
+        }
+    }
+
+    if(current_run.length > 0)
+    {
+        if(fwrite(&current_run, sizeof(current_run), 1, environment_file) != 1)
+            return FAILURE;
+        header.num_wall_runs++;
+    }
+
+    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+    {
+        Exit current_exit = exits_set.list[exit_index];
+        for(int cell_index = 0; cell_index < current_exit->width; cell_index++)
+        {
+            Binary_Location exit_cell = {current_exit->coordinates[cell_index].lin, current_exit->coordinates[cell_index].col};
+            if(fwrite(&exit_cell, sizeof(exit_cell), 1, environment_file) != 1)
+                return FAILURE;
+            header.num_exit_cells++;
+        }
+    }
+
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+    {
+        Pedestrian current_pedestrian = pedestrian_set.by_id[p_index];
+        Binary_Location pedestrian_cell = {current_pedestrian->origin.lin, current_pedestrian->origin.col};
+        if(fwrite(&pedestrian_cell, sizeof(pedestrian_cell), 1, environment_file) != 1)
+            return FAILURE;
+        header.num_pedestrians++;
+    }
+
+    if(fseek(environment_file, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, environment_file) != 1)
+        return FAILURE;
+
+    return SUCCESS;
+}
+
+/**
+ * Writes the loaded environment in the text format.
+ *
+ * @param environment_file File where the environment will be written.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status write_text_environment(FILE *environment_file)
+{
+    size_t line_size = (size_t) cli_args.global_column_number + 1; // Including the '\n'.
+    char *symbols = malloc(line_size * cli_args.global_line_number);
+    if(symbols == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of the symbols of the converted environment.\n");
+        return FAILURE;
+    }
+
+    for(int i = 0; i < cli_args.global_line_number; i++)
+    {
+        char *line = symbols + i * line_size;
+        for(int h = 0; h < cli_args.global_column_number; h++)
+            line[h] = environment_only_grid[i][h] == WALL_VALUE ? '#' : '.';
+        line[cli_args.global_column_number] = '\n';
+    }
+
+    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+    {
+        Exit current_exit = exits_set.list[exit_index];
+        for(int cell_index = 0; cell_index < current_exit->width; cell_index++)
+        {
+            Location exit_cell = current_exit->coordinates[cell_index];
+            symbols[exit_cell.lin * line_size + exit_cell.col] = '_';
+        }
+    }
+
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+    {
+        Location origin = pedestrian_set.by_id[p_index]->origin;
+        symbols[origin.lin * line_size + origin.col] = 'p';
+    }
+
+    Function_Status returned_status = SUCCESS;
+    if(fprintf(environment_file, "%d %d\n", cli_args.global_line_number, cli_args.global_column_number) < 0 ||
+       fwrite(symbols, line_size, cli_args.global_line_number, environment_file) != (size_t) cli_args.global_line_number)
+        returned_status = FAILURE;
+
+    free(symbols);
+
+    return returned_status;
+}
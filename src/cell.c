@@ -11,8 +11,13 @@
 #include"../headers/cell.h"
 #include"../headers/exit.h"
 #include"../headers/grid.h"
+#include"../headers/cli_processing.h"
 #include"../headers/shared_resources.h"
 
+#define NEIGHBOR_BIT(j, k) (1u << (((j) + 1) * 3 + ((k) + 1))) // Bit of the neighbor (j, k) in a neighborhood mask.
+#define NEIGHBORHOOD_CENTER NEIGHBOR_BIT(0, 0)
+
+static unsigned int find_blocked_diagonals(unsigned int wall_neighbors);
 static void sort_cell_list(cell_list neighborhood);
 
 /**
@@ -21,43 +26,41 @@ static void sort_cell_list(cell_list neighborhood);
  * Even if the occupied cells are considered, the pedestrian will not move to a occupied cell and instead will remain in the same
  * place.
  * 
+ * @note The floor field values are compared as integer floor field units, so ties are exact.
+ * @note Walls, unreachable diagonals and occupied cells are determined from the wall_bitmap and occupancy_bitmap, so the 
+ * floor field is only read for the cells that are actually candidates.
+ * 
  * @param ped_coordinates The coordinates of the pedestrian for which to determine the destination cell.
  * @param unoccupied_only A boolean indicating whether to consider only cells not occupied by a pedestrian (True) or not (False).
+ * @param random_number A non-negative random number, which draws one of the cells with the smallest value. It's only drawn
+ * when has_candidate_cells is True for the same arguments.
  * @return A Cell structure representing the destination cell:
  *         - If the pedestrian can move, the Cell will have valid values.
  *         - If the pedestrian must remain in the same place, the Cell will have -1 values.
  *              - If unoccupied_only is true, then this will happen only when there is not a single empty cell in th neighborhood.
  *              - If unoccupied_only is false, then this will happen when the smallest cell is occupied.
 */
-Cell find_smallest_cell(Location ped_coordinates, bool unoccupied_only)
+Cell find_smallest_cell(Location ped_coordinates, bool unoccupied_only, int random_number)
 {
-    Double_Grid final_floor_field = exits_set.final_floor_field;
-    cell_list neighborhood = {0, NULL};
-    neighborhood.list = calloc(1, sizeof(Cell) * 8);
+    Cell neighbor_cells[8];
+    cell_list neighborhood = {0, neighbor_cells};
+
+    unsigned int occupied_neighbors = get_bit_neighborhood(occupancy_bitmap, ped_coordinates, false);
+    unsigned int blocked_neighbors = get_bit_neighborhood(wall_bitmap, ped_coordinates, true) | NEIGHBORHOOD_CENTER;
+
+    blocked_neighbors |= find_blocked_diagonals(blocked_neighbors); // It's impossible to reach these cells.
+
+    if(unoccupied_only)
+        blocked_neighbors |= occupied_neighbors; // Pedestrians in the cells.
 
     for(int j = -1; j < 2; j++)
     {
         for(int k = -1; k < 2; k++)
         {
-            if(j == 0 && k == 0)
-                continue; // The Cell in the given coordinates.
-
-            if(is_within_grid_lines(ped_coordinates.lin + j) == false || is_within_grid_columns(ped_coordinates.col + k) == false)
+            if(blocked_neighbors & NEIGHBOR_BIT(j, k))
                 continue;
 
-            double cell_value = final_floor_field[ped_coordinates.lin + j][ped_coordinates.col + k];
-
-            if(cell_value == WALL_VALUE)
-                continue;
-
-            if(j != 0 && k != 0)
-            {
-                if( is_diagonal_valid(ped_coordinates,(Location){j,k},final_floor_field) == false)
-                    continue; // It's impossible to reach the cell.
-            }
-
-            if(unoccupied_only && pedestrian_position_grid[ped_coordinates.lin + j][ped_coordinates.col + k] > 0)
-                continue; // Pedestrian in the cell.
+            int cell_value = get_field_units(exits_set.final_floor_field, ped_coordinates.lin + j, ped_coordinates.col + k);
 
             Cell neighbor_cell = {{ped_coordinates.lin + j, ped_coordinates.col + k}, cell_value};
             neighborhood.list[neighborhood.num_cells] = neighbor_cell;
@@ -81,18 +84,91 @@ Cell find_smallest_cell(Location ped_coordinates, bool unoccupied_only)
             same_value++;
         }
 
-        int drawn_cell = rand() % same_value;
+        int drawn_cell = random_number % same_value;
+        Location drawn_coordinates = neighborhood.list[drawn_cell].coordinates;
 
-        if(pedestrian_position_grid[neighborhood.list[drawn_cell].coordinates.lin][neighborhood.list[drawn_cell].coordinates.col] == 0)
+        if((occupied_neighbors & NEIGHBOR_BIT(drawn_coordinates.lin - ped_coordinates.lin, drawn_coordinates.col - ped_coordinates.col)) == 0)
             destination_cell = neighborhood.list[drawn_cell]; 
             // Only if the sorted cell is not occupied.
     }
 
-    free(neighborhood.list);
-
     return destination_cell;
 }
 
+/**
+ * Verifies if find_smallest_cell has at least one cell to choose from, i.e., if it uses its random number.
+ *
+ * @param ped_coordinates The coordinates of the pedestrian.
+ * @param unoccupied_only A boolean indicating whether to consider only cells not occupied by a pedestrian (True) or not (False).
+ * @return bool, where True indicates that there is a candidate cell and False otherwise.
+*/
+bool has_candidate_cells(Location ped_coordinates, bool unoccupied_only)
+{
+    unsigned int blocked_neighbors = get_bit_neighborhood(wall_bitmap, ped_coordinates, true) | NEIGHBORHOOD_CENTER;
+
+    blocked_neighbors |= find_blocked_diagonals(blocked_neighbors);
+
+    if(unoccupied_only)
+        blocked_neighbors |= get_bit_neighborhood(occupancy_bitmap, ped_coordinates, false);
+
+    for(int j = -1; j < 2; j++)
+    {
+        for(int k = -1; k < 2; k++)
+        {
+            if((blocked_neighbors & NEIGHBOR_BIT(j, k)) == 0)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Verifies if a pedestrian at the given Location can't move to any cell of its neighborhood, since every neighbor is a wall,
+ * an unreachable diagonal or occupied by another pedestrian.
+ *
+ * @note Unlike find_smallest_cell, doesn't need random numbers.
+ *
+ * @param ped_coordinates The coordinates of the pedestrian.
+ * @return bool, where True indicates that the pedestrian is enclosed and False otherwise.
+*/
+bool is_cell_enclosed(Location ped_coordinates)
+{
+    return ! has_candidate_cells(ped_coordinates, true);
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Determines which diagonal neighbors can't be reached from the center of a neighborhood, following the same rules of
+ * is_diagonal_valid.
+ *
+ * @param wall_neighbors Neighborhood mask where set bits indicate walls and obstacles.
+ * @return A neighborhood mask where set bits indicate the unreachable diagonals.
+*/
+static unsigned int find_blocked_diagonals(unsigned int wall_neighbors)
+{
+    unsigned int blocked_diagonals = 0;
+
+    for(int j = -1; j < 2; j += 2)
+    {
+        for(int k = -1; k < 2; k += 2)
+        {
+            bool is_vertical_blocked = wall_neighbors & NEIGHBOR_BIT(j, 0);
+            bool is_horizontal_blocked = wall_neighbors & NEIGHBOR_BIT(0, k);
+
+            if(is_vertical_blocked && is_horizontal_blocked)
+                blocked_diagonals |= NEIGHBOR_BIT(j, k);
+            else if(cli_args.prevent_corner_crossing && (is_vertical_blocked || is_horizontal_blocked))
+                blocked_diagonals |= NEIGHBOR_BIT(j, k);
+        }
+    }
+
+    return blocked_diagonals;
+}
+
 /**
  * Sorts the given cell_list in ascending order.
  * 
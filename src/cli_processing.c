@@ -28,6 +28,8 @@ const char doc[] = "Varas - Simulates pedestrian evacuation using the Varas (200
 "\t\t4 - (default) Environment structure, static exits and static pedestrians.\n"
 "\tEnvironment auto created:\n"
 "\t\t5 - Environment structure will be a empty room with dimensions of LINES and COLUMNS (including the walls surrounding it).\n"
+"\tEnvironment loaded from an image:\n"
+"\t\t6 - Environment structure, static exits and static pedestrians from a PGM image (P2 or P5).\n"
 "Choices 1, 3 and 5 require the file provided by the --auxiliary-file option in order to include exits in the simulation.\n"
 "\n"
 "The --output-format option specifies which data generated by the simulations shall be written to the output stream. The following choices are available:\n"
@@ -35,6 +37,28 @@ const char doc[] = "Varas - Simulates pedestrian evacuation using the Varas (200
 "\t 2 - Number of timesteps required for the termination of each simulation.\n"
 "\t 3 - Heatmap of the environment cells.\n"
 "\n"
+"The --field-precision option specifies how the floor field of each exit and the final floor field are stored. The following choices are available:\n"
+"\t 1 - (default) Double precision floating-point (8 bytes per cell).\n"
+"\t 2 - Single precision floating-point (4 bytes per cell).\n"
+"\t 3 - 16 bits fixed-point, in units of 1 / q, where DIAGONAL = p / q (2 bytes per cell).\n"
+"\t 4 - 32 bits fixed-point, in units of 1 / q, where DIAGONAL = p / q (4 bytes per cell).\n"
+"The program ends with an error if a floor field value can't be exactly stored with the chosen precision.\n"
+"\n"
+"The --grid-layout option specifies how the cells of the floor fields are ordered in memory. The following choices are available:\n"
+"\t 1 - (default) Row-major, one line after the other.\n"
+"\t 2 - Tiled, in square tiles of 8 x 8 cells stored one after the other.\n"
+"\t 3 - Morton (Z-order) curve.\n"
+"The tiled and Morton layouts keep the neighborhood of each cell closer in memory, which benefits large environments.\n"
+"\n"
+"With --combine-exits=K, the exits of the file provided by --auxiliary-file are taken as candidates, regardless of the simulation set they belong to, and every combination of K distinct candidates "
+"(or of K candidates with repetition, when --with-repetition is given) is run as a simulation set, in lexicographic order. Repeated candidates appear only once in their simulation set. "
+"Combined with --floor-field-cache, the floor field of each candidate is calculated a single time.\n"
+"\n"
+"For PGM images, the gray level of each pixel, scaled to the range 0 - 255, is compared with the thresholds provided by --pgm-thresholds=WALL,EXIT,PEDESTRIAN (default is 64,128,192): "
+"darker pixels than WALL are walls, darker than EXIT are exits, darker than PEDESTRIAN are pedestrians, and the remaining ones are empty. "
+"With --pgm-downsample=FACTOR, each cell represents a block of FACTOR x FACTOR pixels, which is an exit if any of its pixels is an exit, otherwise a wall if any of them is a wall, "
+"otherwise a pedestrian if any of them is a pedestrian. Connected exit cells form a single exit.\n"
+"\n"
 "Unnecessary options for some --env-load-method are ignored.\n";
 
 /* Keys for options without short-options. */
@@ -47,6 +71,28 @@ const char doc[] = "Varas - Simulates pedestrian evacuation using the Varas (200
 #define OPT_AVOID_CORNER_MOVEMENT 1006
 #define OPT_ALLOW_X_MOVEMENT 1007
 #define OPT_SINGLE_EXIT_FLAG 1008
+#define OPT_FIELD_PRECISION 1010
+#define OPT_GRID_LAYOUT 1011
+#define OPT_SPATIAL_SORT 1012
+#define OPT_CONVERT_ENV 1013
+#define OPT_PGM_THRESHOLDS 1014
+#define OPT_PGM_DOWNSAMPLE 1015
+#define OPT_COMBINE_EXITS 1016
+#define OPT_WITH_REPETITION 1017
+#define OPT_FLOOR_FIELD_CACHE 1018
+#define OPT_THREADS 1019
+#define OPT_PIPELINE_DEPTH 1020
+#define OPT_MAX_TIMESTEPS 1021
+#define OPT_STALL_LIMIT 1022
+#define OPT_CI_HALF_WIDTH 1023
+#define OPT_MIN_SIMULATIONS 1024
+#define OPT_SUCCESSIVE_HALVING 1025
+#define OPT_BRANCH_AND_BOUND 1026
+#define OPT_DEDUPLICATE_SETS 1027
+#define OPT_SWEEP 1028
+#define OPT_BATCH 1029
+#define OPT_SHARD 1030
+#define OPT_MERGE_SHARDS 1031
 #define OPT_VARAS_FIG7 2001
 
 struct argp_option options[] = {
@@ -54,10 +100,16 @@ struct argp_option options[] = {
     {"env-file", 'e', "ENV-FILE", 0, "Name of the file that contains environment information: dimensions and its mapped features, including obstacles, walls, and optionally, pedestrians and doors.",2},
     {"output-file", 'o', "OUTPUT-FILE", OPTION_ARG_OPTIONAL, "Specifies whether the output should be stored in a file (default is stdout), with the file name being optionally provided."},
     {"auxiliary-file", 'a', "AUXILIARY-FILE",0, "Name of the configuration file that contains the coordinates of exits for each simulation set."},
+    {"convert-env", OPT_CONVERT_ENV, "NEW-ENV-FILE", 0, "Converts the environment file to the binary format, or a binary environment file back to the text format, storing the result in NEW-ENV-FILE. No simulation is run."},
+    {"batch", OPT_BATCH, "BATCH-FILE", 0, "Runs, in a single process, the executions listed in BATCH-FILE, one per line with the options of the command line. Environments and floor fields are shared by consecutive runs that use them, and the other options given with --batch are shared by every run."},
+    {"merge-shards", OPT_MERGE_SHARDS, "SHARD-FILES", 0, "Merges the output files of the shards of an execution, given as a comma separated list in the order of the shards, into the output of the unsharded execution. No simulation is run."},
 
     {"\nInput/Output Configuration:\n",0,0,OPTION_DOC,0,3},    
     {"env-load-method", 'm', "METHOD",0, "How the environment will be loaded or whether it will be created.",4},
     {"output-format", 'O', "FORMAT", 0, "The type of output to be generated by the simulations."},
+    {"pgm-thresholds", OPT_PGM_THRESHOLDS, "WALL,EXIT,PEDESTRIAN", 0, "Gray levels (0 - 256) separating walls, exits, pedestrians and empty cells in PGM images (default is 64,128,192)."},
+    {"pgm-downsample", OPT_PGM_DOWNSAMPLE, "FACTOR", 0, "Number of pixels of a PGM image, in each direction, represented by a single cell (default is 1)."},
+    {"combine-exits", OPT_COMBINE_EXITS, "K", 0, "Runs a simulation set for every combination of K exits among the exits of the auxiliary file, instead of the simulation sets it describes."},
     
     {"\nEnvironment Dimensions (required for auto created environments):\n",0,0,OPTION_DOC,0,5},
     {"lin", 'l', "LINES", 0, "Number of lines for the environment when it is being created.",6},
@@ -66,8 +118,20 @@ struct argp_option options[] = {
     {"\nSimulation Variables (optional):\n",0,0,OPTION_DOC,0,7},
     {"ped", 'p', "PEDESTRIANS", 0, "Number of pedestrians to be randomly placed in the environment (default is 1).",8},
     {"simu", 's', "SIMULATIONS", 0, "Number of simulations for each simulation set (default is 1)."},
+    {"ci-half-width", OPT_CI_HALF_WIDTH, "TIMESTEPS", 0, "Runs simulations of each simulation set until the half-width of the 95% confidence interval of its mean number of timesteps is at most TIMESTEPS, with --simu becoming the maximum number of simulations (default is 0, disabled). The number of simulations run is reported for each simulation set."},
+    {"min-simulations", OPT_MIN_SIMULATIONS, "SIMULATIONS", 0, "Minimum number of simulations of each simulation set when --ci-half-width is given (default is 5)."},
+    {"successive-halving", OPT_SUCCESSIVE_HALVING, "ROUNDS", 0, "Searches for the simulation sets with the smallest mean number of timesteps in up to ROUNDS rounds. Every simulation set runs --simu simulations in the first round; after each round the worst half is discarded and the simulations of the others are doubled. A ranking of the simulation sets is written instead of the usual output (default is 0, disabled)."},
+    {"sweep", OPT_SWEEP, "PARAMETER:VALUES", 0, "Runs the simulation sets once for each value of PARAMETER (p, diagonal, seed, immediate-exit, always-to-lowest, avoid-corner-movement, allow-x-movement or varas-fig7), combined with the values of the other swept parameters, in a single execution. VALUES is a comma separated list, where p and seed also accept ranges (e.g. seed:0-9), and the toggle options take 0 or 1. May be given once for each parameter."},
+    {"shard", OPT_SHARD, "I/N", 0, "Runs only the simulation sets of the auxiliary file whose index modulo N is I (0 <= I < N), with the same seeds as the unsharded execution, so that the output files of the N shards can be merged with --merge-shards."},
     {"seed", OPT_SEED, "SEED", 0, "Initial seed for the srand function (default is 0)."},
     {"diagonal", OPT_DIAGONAL, "DIAGONAL", 0, "The diagonal value for calculation of the static floor field (default is 1.5)."},
+    {"field-precision", OPT_FIELD_PRECISION, "PRECISION", 0, "How the floor fields are stored in memory (default is double precision)."},
+    {"grid-layout", OPT_GRID_LAYOUT, "LAYOUT", 0, "How the cells of the floor fields are ordered in memory (default is row-major)."},
+    {"threads", OPT_THREADS, "THREADS", 0, "Number of threads used to calculate the floor fields of the exits of each simulation set, or the floor field of a single exit, and to merge them (default is 1). The results don't depend on it."},
+    {"pipeline-depth", OPT_PIPELINE_DEPTH, "SETS", 0, "Number of simulation sets of the auxiliary file whose floor fields are calculated ahead, in a background thread, while the simulations of the current set run. With --threads, the sets are prepared in parallel, the most expensive first (default is 0, disabled)."},
+    {"max-timesteps", OPT_MAX_TIMESTEPS, "TIMESTEPS", 0, "Interrupts any simulation that reaches TIMESTEPS timesteps, reporting it with -2 as its number of timesteps (default is 0, no limit)."},
+    {"stall-limit", OPT_STALL_LIMIT, "TIMESTEPS", 0, "Interrupts any simulation in which no pedestrian moves or leaves the environment for TIMESTEPS consecutive timesteps, reporting it with -2 as its number of timesteps (default is 0, disabled). Simulations where no pedestrian can ever move again are always interrupted."},
+    {"spatial-sort", OPT_SPATIAL_SORT, "TIMESTEPS", 0, "Re-sorts the pedestrians along a Morton curve of their locations every TIMESTEPS timesteps, improving memory locality for large crowds (default is 0, never). Pedestrian IDs and the results are kept, since random numbers are still drawn in the ID order."},
 
     {"\nToggle Options (optional):\n",0,0,OPTION_DOC,0,9},
     {"debug", OPT_DEBUG, 0,0 , "Prints debug information to stdout.",10},
@@ -77,6 +141,10 @@ struct argp_option options[] = {
     {"avoid-corner-movement",OPT_AVOID_CORNER_MOVEMENT,0,0, "Prevents movement in the corners of walls and obstacles. A single diagonal movement through the corner of a obstacle becomes three movements."},
     {"allow-x-movement",OPT_ALLOW_X_MOVEMENT,0,0, "The movement of pedestrians isn't restricted when X movements occur."},
     {"single-exit-flag", OPT_SINGLE_EXIT_FLAG, 0,0, "Prints a flag (#1) before the results for every simulation set that has only one exit."},
+    {"with-repetition", OPT_WITH_REPETITION, 0, 0, "The combinations of --combine-exits may repeat an exit."},
+    {"floor-field-cache", OPT_FLOOR_FIELD_CACHE, 0, 0, "Keeps the floor field of every exit already calculated, reusing it whenever the exit appears in another simulation set."},
+    {"branch-and-bound", OPT_BRANCH_AND_BOUND, 0, 0, "Searches for the simulation sets with the smallest mean number of timesteps, simulating them in increasing order of a lower bound of their number of timesteps, obtained from the floor field, and skipping those whose lower bound exceeds the best mean so far. A ranking of the simulation sets is written instead of the usual output."},
+    {"deduplicate-sets", OPT_DEDUPLICATE_SETS, 0, 0, "Simulates only the first of the simulation sets of the auxiliary file with the same exits, in any order, writing its results again for the others. Not available for the visual output format."},
     {"varas-fig7", OPT_VARAS_FIG7, 0, 0, "Doesn't allow any pedestrians to be randomly placed in the first two columns on the left of the environment, in accordance with the experiment in Fig. 7 of the Varas article."},
 
     {"\nAdditional Information:\n",0,0,OPTION_DOC,0,11},
@@ -90,8 +158,14 @@ Command_Line_Args cli_args = {
     .environment_filename="varas_queue.txt",
     .output_filename="",
     .auxiliary_filename="",
+    .converted_environment_filename="",
+    .batch_filename="",
+    .merged_shard_filenames="",
+    .sweep_specifications="",
     .output_format = OUTPUT_VISUALIZATION,
     .environment_origin = STRUCTURE_DOORS_AND_PEDESTRIANS,
+    .field_precision = PRECISION_DOUBLE,
+    .grid_layout = LAYOUT_ROW_MAJOR,
     .write_to_file=false,
     .show_debug_information=false,
     .show_simulation_set_info=false,
@@ -101,12 +175,31 @@ Command_Line_Args cli_args = {
     .allow_X_movement = false,
     .single_exit_flag = false,
     .varas_fig7=false,
+    .combination_with_repetition = false,
+    .use_floor_field_cache = false,
     .global_line_number = 0,
     .global_column_number = 0,
     .num_simulations = 1, // A single simulation by default.
     .total_num_pedestrians = 1,
     .seed = 0,
-    .diagonal = 1.5
+    .spatial_sort_interval = 0,
+    .pgm_thresholds = {64, 128, 192},
+    .pgm_downsample_factor = 1,
+    .exit_combination_size = 0,
+    .num_threads = 1,
+    .pipeline_depth = 0,
+    .max_timesteps = 0,
+    .stall_limit = 0,
+    .ci_half_width = 0,
+    .min_simulations = 5,
+    .successive_halving_rounds = 0,
+    .use_branch_and_bound = false,
+    .deduplicate_sets = false,
+    .shard_index = 0,
+    .num_shards = 0,
+    .diagonal = 1.5,
+    .diagonal_numerator = 3,
+    .diagonal_denominator = 2
 };
 // When loading an environment global_line_number and global_column_number will no be obtained from the command line arguments. Besides, total_num_pedestrians will be automatic determined by the program on some environment origin formats.
 
@@ -149,7 +242,7 @@ error_t parser_function(int key, char *arg, struct argp_state *state)
             break;
         case 'm':
             int environment_origin = atoi(arg);
-            if(environment_origin < ONLY_STRUCTURE || environment_origin > AUTOMATIC_CREATED)
+            if(environment_origin < ONLY_STRUCTURE || environment_origin > PGM_IMAGE)
             {
                 fprintf(stderr, "Invalid environment load method.\n");
                 return EIO;
@@ -159,6 +252,37 @@ error_t parser_function(int key, char *arg, struct argp_state *state)
         case 'a':
             strcpy(cli_args->auxiliary_filename, arg);
             break;
+        case OPT_CONVERT_ENV:
+            strcpy(cli_args->converted_environment_filename, arg);
+            break;
+        case OPT_BATCH:
+            strcpy(cli_args->batch_filename, arg);
+            break;
+        case OPT_MERGE_SHARDS:
+            if(strlen(arg) >= sizeof(cli_args->merged_shard_filenames))
+            {
+                fprintf(stderr, "The list of output files of the shards is too long.\n");
+                return EIO;
+            }
+            strcpy(cli_args->merged_shard_filenames, arg);
+            break;
+        case OPT_PGM_THRESHOLDS:
+            int *thresholds = cli_args->pgm_thresholds;
+            if(sscanf(arg, "%d,%d,%d", &thresholds[0], &thresholds[1], &thresholds[2]) != 3 || thresholds[0] < 0 || 
+               thresholds[0] > thresholds[1] || thresholds[1] > thresholds[2] || thresholds[2] > 256)
+            {
+                fprintf(stderr, "The PGM thresholds must be three non-decreasing gray levels between 0 and 256, separated by commas.\n");
+                return EIO;
+            }
+            break;
+        case OPT_PGM_DOWNSAMPLE:
+            cli_args->pgm_downsample_factor = atoi(arg);
+            if(cli_args->pgm_downsample_factor <= 0)
+            {
+                fprintf(stderr, "The PGM downsampling factor must be positive.\n");
+                return EIO;
+            }
+            break;
         case 'l':
             cli_args->global_line_number = atoi(arg);
             if(cli_args->global_line_number <= 0)
@@ -198,6 +322,30 @@ error_t parser_function(int key, char *arg, struct argp_state *state)
                 fprintf(stderr, "The diagonal value must be non-negative.\n");
                 return EIO;
             }
+
+            if(extract_diagonal_fraction(arg, &cli_args->diagonal_numerator, &cli_args->diagonal_denominator) == FAILURE)
+            {
+                fprintf(stderr, "The diagonal value must be a decimal number with at most 6 decimal places.\n");
+                return EIO;
+            }
+            break;
+        case OPT_FIELD_PRECISION:
+            int field_precision = atoi(arg);
+            if(field_precision < PRECISION_DOUBLE || field_precision > PRECISION_FIXED_32)
+            {
+                fprintf(stderr, "Invalid floor field precision.\n");
+                return EIO;
+            }
+            cli_args->field_precision = (enum Field_Precision) field_precision;
+            break;
+        case OPT_GRID_LAYOUT:
+            int grid_layout = atoi(arg);
+            if(grid_layout < LAYOUT_ROW_MAJOR || grid_layout > LAYOUT_MORTON)
+            {
+                fprintf(stderr, "Invalid grid layout.\n");
+                return EIO;
+            }
+            cli_args->grid_layout = (enum Grid_Layout) grid_layout;
             break;
         case OPT_SEED:
             cli_args->seed = atoi(arg);
@@ -207,6 +355,98 @@ error_t parser_function(int key, char *arg, struct argp_state *state)
                 return EIO;
             }
             break;
+        case OPT_SPATIAL_SORT:
+            cli_args->spatial_sort_interval = atoi(arg);
+            if(cli_args->spatial_sort_interval < 0)
+            {
+                fprintf(stderr, "The number of timesteps between spatial sortings must be non-negative.\n");
+                return EIO;
+            }
+            break;
+        case OPT_THREADS:
+            cli_args->num_threads = atoi(arg);
+            if(cli_args->num_threads <= 0)
+            {
+                fprintf(stderr, "The number of threads must be positive.\n");
+                return EIO;
+            }
+            break;
+        case OPT_PIPELINE_DEPTH:
+            cli_args->pipeline_depth = atoi(arg);
+            if(cli_args->pipeline_depth < 0)
+            {
+                fprintf(stderr, "The number of simulation sets prepared ahead must be non-negative.\n");
+                return EIO;
+            }
+            break;
+        case OPT_MAX_TIMESTEPS:
+            cli_args->max_timesteps = atoi(arg);
+            if(cli_args->max_timesteps < 0)
+            {
+                fprintf(stderr, "The maximum number of timesteps must be non-negative.\n");
+                return EIO;
+            }
+            break;
+        case OPT_STALL_LIMIT:
+            cli_args->stall_limit = atoi(arg);
+            if(cli_args->stall_limit < 0)
+            {
+                fprintf(stderr, "The number of timesteps without progress must be non-negative.\n");
+                return EIO;
+            }
+            break;
+        case OPT_CI_HALF_WIDTH:
+            cli_args->ci_half_width = atof(arg);
+            if(cli_args->ci_half_width < 0)
+            {
+                fprintf(stderr, "The half-width of the confidence interval must be non-negative.\n");
+                return EIO;
+            }
+            break;
+        case OPT_MIN_SIMULATIONS:
+            cli_args->min_simulations = atoi(arg);
+            if(cli_args->min_simulations < 2)
+            {
+                fprintf(stderr, "The minimum number of simulations must be at least 2.\n");
+                return EIO;
+            }
+            break;
+        case OPT_SUCCESSIVE_HALVING:
+            cli_args->successive_halving_rounds = atoi(arg);
+            if(cli_args->successive_halving_rounds < 0)
+            {
+                fprintf(stderr, "The number of rounds of the successive halving must be non-negative.\n");
+                return EIO;
+            }
+            break;
+        case OPT_SWEEP:
+            if(strlen(cli_args->sweep_specifications) + strlen(arg) + 1 >= sizeof(cli_args->sweep_specifications))
+            {
+                fprintf(stderr, "The parameters given to --sweep must have less than %zu characters in total.\n", sizeof(cli_args->sweep_specifications) - 1);
+                return EIO;
+            }
+
+            if(strcmp(cli_args->sweep_specifications, "") != 0)
+                strcat(cli_args->sweep_specifications, " ");
+            strcat(cli_args->sweep_specifications, arg); // Parsed by load_sweep_parameters.
+            break;
+        case OPT_SHARD:
+            char trailing_character;
+            if(sscanf(arg, "%d/%d%c", &cli_args->shard_index, &cli_args->num_shards, &trailing_character) != 2 ||
+               cli_args->num_shards <= 0 || cli_args->shard_index < 0 || cli_args->shard_index >= cli_args->num_shards)
+            {
+                fprintf(stderr, "The shard must be given as I/N, with 0 <= I < N.\n");
+                return EIO;
+            }
+            break;
+        case OPT_COMBINE_EXITS:
+            cli_args->exit_combination_size = atoi(arg);
+            if(cli_args->exit_combination_size <= 0)
+            {
+                fprintf(stderr, "The number of exits in each combination must be positive.\n");
+                return EIO;
+            }
+            break;
         case OPT_DEBUG:
             cli_args->show_debug_information = true;
             break;
@@ -231,11 +471,40 @@ error_t parser_function(int key, char *arg, struct argp_state *state)
         case OPT_VARAS_FIG7:
             cli_args->varas_fig7 = true;
             break;
+        case OPT_WITH_REPETITION:
+            cli_args->combination_with_repetition = true;
+            break;
+        case OPT_FLOOR_FIELD_CACHE:
+            cli_args->use_floor_field_cache = true;
+            break;
+        case OPT_BRANCH_AND_BOUND:
+            cli_args->use_branch_and_bound = true;
+            break;
+        case OPT_DEDUPLICATE_SETS:
+            cli_args->deduplicate_sets = true;
+            break;
         case ARGP_KEY_ARG:
             fprintf(stderr, "No positional argument was expect, but %s was given.\n", arg);
             return EINVAL;
             break;
         case ARGP_KEY_END:
+            if(strcmp(cli_args->merged_shard_filenames, "") != 0)
+                break; // Only the output files of the shards are used.
+
+            if(strcmp(cli_args->batch_filename, "") != 0)
+            {
+                if(strcmp(cli_args->sweep_specifications, "") != 0)
+                {
+                    fprintf(stderr, "--sweep must be given in the lines of the batch file.\n");
+                    return EIO;
+                }
+
+                break; // The options of each run are verified when its line is parsed.
+            }
+
+            if(strcmp(cli_args->converted_environment_filename, "") != 0 && cli_args->environment_origin != PGM_IMAGE)
+                cli_args->environment_origin = STRUCTURE_DOORS_AND_PEDESTRIANS; // The static exits and pedestrians are converted as well.
+
             if(origin_uses_auxiliary_data() == true)
             {
                 if( strcmp(cli_args->auxiliary_filename,"") == 0)
@@ -250,6 +519,43 @@ error_t parser_function(int key, char *arg, struct argp_state *state)
                     strcpy(cli_args->auxiliary_filename,""); // when the auxiliary file is not needed.
             }
 
+            if(cli_args->ci_half_width > 0 && cli_args->min_simulations > cli_args->num_simulations)
+            {
+                fprintf(stderr, "The minimum number of simulations can't be greater than the number of simulations (--simu).\n");
+                return EIO;
+            }
+
+            if((cli_args->successive_halving_rounds > 0 || cli_args->use_branch_and_bound) && origin_uses_auxiliary_data() == false)
+            {
+                fprintf(stderr, "--successive-halving and --branch-and-bound require the simulation sets of an auxiliary file (--env-load-method 1, 3 or 5).\n");
+                return EIO;
+            }
+
+            if(cli_args->deduplicate_sets && (origin_uses_auxiliary_data() == false || cli_args->output_format == OUTPUT_VISUALIZATION))
+            {
+                fprintf(stderr, "--deduplicate-sets requires the simulation sets of an auxiliary file (--env-load-method 1, 3 or 5) and isn't available for the visual output format.\n");
+                return EIO;
+            }
+
+            if(strcmp(cli_args->sweep_specifications, "") != 0 && (cli_args->successive_halving_rounds > 0 || cli_args->use_branch_and_bound))
+            {
+                fprintf(stderr, "--sweep can't be combined with --successive-halving or --branch-and-bound.\n");
+                return EIO;
+            }
+
+            if(cli_args->num_shards > 0 && (origin_uses_auxiliary_data() == false || cli_args->successive_halving_rounds > 0 || cli_args->use_branch_and_bound ||
+                                            cli_args->deduplicate_sets || strcmp(cli_args->sweep_specifications, "") != 0))
+            {
+                fprintf(stderr, "--shard requires the simulation sets of an auxiliary file (--env-load-method 1, 3 or 5) and can't be combined with --successive-halving, --branch-and-bound, --deduplicate-sets or --sweep.\n");
+                return EIO;
+            }
+
+            if((cli_args->successive_halving_rounds > 0) + cli_args->use_branch_and_bound + (cli_args->ci_half_width > 0) > 1)
+            {
+                fprintf(stderr, "Only one of --successive-halving, --branch-and-bound and --ci-half-width can be used.\n");
+                return EIO;
+            }
+
             if(cli_args->environment_origin == AUTOMATIC_CREATED)
             {
                 if(cli_args->global_line_number == 0 || cli_args->global_column_number == 0)
@@ -306,12 +612,72 @@ void extract_full_command(char *full_command, int key, char *arg)
         case OPT_VARAS_FIG7:
             sprintf(aux, " --varas-fig7");
             break;
+        case OPT_WITH_REPETITION:
+            sprintf(aux, " --with-repetition");
+            break;
+        case OPT_FLOOR_FIELD_CACHE:
+            sprintf(aux, " --floor-field-cache");
+            break;
+        case OPT_BRANCH_AND_BOUND:
+            sprintf(aux, " --branch-and-bound");
+            break;
+        case OPT_DEDUPLICATE_SETS:
+            sprintf(aux, " --deduplicate-sets");
+            break;
+        case OPT_THREADS:
+            sprintf(aux, " --threads=%s", arg);
+            break;
+        case OPT_PIPELINE_DEPTH:
+            sprintf(aux, " --pipeline-depth=%s", arg);
+            break;
+        case OPT_MAX_TIMESTEPS:
+            sprintf(aux, " --max-timesteps=%s", arg);
+            break;
+        case OPT_STALL_LIMIT:
+            sprintf(aux, " --stall-limit=%s", arg);
+            break;
+        case OPT_CI_HALF_WIDTH:
+            sprintf(aux, " --ci-half-width=%s", arg);
+            break;
+        case OPT_MIN_SIMULATIONS:
+            sprintf(aux, " --min-simulations=%s", arg);
+            break;
+        case OPT_SUCCESSIVE_HALVING:
+            sprintf(aux, " --successive-halving=%s", arg);
+            break;
+        case OPT_SWEEP:
+            snprintf(aux, sizeof(aux), " --sweep=%s", arg);
+            break;
+        case OPT_SHARD:
+            snprintf(aux, sizeof(aux), " --shard=%s", arg);
+            break;
+        case OPT_COMBINE_EXITS:
+            sprintf(aux, " --combine-exits=%s", arg);
+            break;
         case OPT_SEED:
             sprintf(aux, " --seed=%s", arg);
             break;
         case OPT_DIAGONAL:
             sprintf(aux, " --diagonal=%s", arg);
             break;
+        case OPT_SPATIAL_SORT:
+            sprintf(aux, " --spatial-sort=%s", arg);
+            break;
+        case OPT_CONVERT_ENV:
+            sprintf(aux, " --convert-env=%s", arg);
+            break;
+        case OPT_PGM_THRESHOLDS:
+            sprintf(aux, " --pgm-thresholds=%s", arg);
+            break;
+        case OPT_PGM_DOWNSAMPLE:
+            sprintf(aux, " --pgm-downsample=%s", arg);
+            break;
+        case OPT_FIELD_PRECISION:
+            sprintf(aux, " --field-precision=%s", arg);
+            break;
+        case OPT_GRID_LAYOUT:
+            sprintf(aux, " --grid-layout=%s", arg);
+            break;
         case 'o':
         case 'O':
         case 'e':
@@ -332,4 +698,60 @@ void extract_full_command(char *full_command, int key, char *arg)
     }
 
     strcat(full_command, aux);
-}
\ No newline at end of file
+}
+
+/**
+ * Extracts the fraction, in lowest terms, that represents the diagonal value written in decimal notation (e.g. 1.5 is 3 / 2).
+ * 
+ * @param diagonal_text The diagonal value, as received by the CLI.
+ * @param numerator Pointer to a integer, where the numerator of the fraction will be stored.
+ * @param denominator Pointer to a integer, where the denominator of the fraction will be stored.
+ * @return Function_Status: FAILURE (0), if the text isn't a non-negative decimal number with at most 6 decimal places, or SUCCESS (1).
+*/
+Function_Status extract_diagonal_fraction(const char *diagonal_text, int *numerator, int *denominator)
+{
+    long long int fraction_numerator = 0, fraction_denominator = 1;
+    int num_digits = 0, num_decimal_places = 0;
+    bool after_point = false;
+
+    for(const char *c = diagonal_text; *c != '\0'; c++)
+    {
+        if(*c == '.' && after_point == false)
+        {
+            after_point = true;
+            continue;
+        }
+
+        if(*c < '0' || *c > '9' || num_digits >= 12)
+            return FAILURE;
+
+        if(after_point)
+        {
+            if(num_decimal_places == 6)
+                return FAILURE;
+
+            num_decimal_places++;
+            fraction_denominator *= 10;
+        }
+
+        fraction_numerator = fraction_numerator * 10 + (*c - '0');
+        num_digits++;
+    }
+
+    if(num_digits == 0 || fraction_numerator > 1000000000)
+        return FAILURE;
+
+    long long int a = fraction_numerator, b = fraction_denominator;
+    while(b != 0)
+    {
+        long long int remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+    // a holds the greatest common divisor (or the denominator, when the numerator is zero).
+
+    *numerator = fraction_numerator / a;
+    *denominator = fraction_denominator / a;
+
+    return SUCCESS;
+}
@@ -0,0 +1,344 @@
+/*
+   File: connectivity.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module implements the connected components of the free cells of the environment, labeled once under the
+                movement rules (including --avoid-corner-movement). Each simulation set is verified against them before its floor
+                fields are calculated, rejecting the sets that leave pedestrians in a component without exits, and the floor field
+                of each exit is only calculated within the components it reaches.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdbool.h>
+#include<pthread.h>
+
+#include"../headers/exit.h"
+#include"../headers/grid.h"
+#include"../headers/pedestrian.h"
+#include"../headers/connectivity.h"
+#include"../headers/initialization.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+#define NO_COMPONENT -1
+
+typedef struct{
+    Location first_cell; // Top left corner of the bounding box of the component.
+    Location last_cell; // Bottom right corner of the bounding box of the component.
+    bool is_populated; // Pedestrians are, or may be randomly, placed in the component.
+    unsigned int reached_mark; // Number of the last verification in which an exit reached the component.
+}environment_component;
+
+static int *component_labels = NULL; // Component of each cell, line after line, or NO_COMPONENT for walls.
+static environment_component *components = NULL;
+static int num_components = 0;
+static int num_populated_components = 0;
+static unsigned int verification_number = 0;
+static pthread_mutex_t verification_lock = PTHREAD_MUTEX_INITIALIZER; // The pipeline may verify several simulation sets at once.
+
+static Function_Status label_component(Location first_cell, Location *cell_queue);
+static void mark_populated_components();
+static int get_adjacent_component(Location cell, int line_offset, int column_offset);
+static bool is_diagonal_open(Location cell, int line_offset, int column_offset);
+static void expand_bounds(Location *first_cell, Location *last_cell, Location new_first_cell, Location new_last_cell);
+
+/**
+ * Labels the connected components of the free cells of the environment and determines which of them are populated.
+ *
+ * @note Must be called after the environment, and its static pedestrians, are loaded.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status label_environment_components()
+{
+    size_t num_cells = (size_t) cli_args.global_line_number * cli_args.global_column_number;
+
+    component_labels = malloc(sizeof(int) * num_cells);
+    Location *cell_queue = malloc(sizeof(Location) * num_cells);
+    if(component_labels == NULL || cell_queue == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of the connected components of the environment.\n");
+        free(cell_queue);
+        return FAILURE;
+    }
+
+    for(size_t cell_index = 0; cell_index < num_cells; cell_index++)
+        component_labels[cell_index] = NO_COMPONENT;
+
+    Function_Status returned_status = SUCCESS;
+    for(int i = 0; i < cli_args.global_line_number && returned_status == SUCCESS; i++)
+    {
+        for(int h = 0; h < cli_args.global_column_number && returned_status == SUCCESS; h++)
+        {
+            if(environment_only_grid[i][h] == WALL_VALUE || component_labels[(size_t) i * cli_args.global_column_number + h] != NO_COMPONENT)
+                continue;
+
+            returned_status = label_component((Location){i, h}, cell_queue);
+        }
+    }
+
+    free(cell_queue);
+
+    if(returned_status == SUCCESS)
+        mark_populated_components();
+
+    return returned_status;
+}
+
+/**
+ * Verifies if every exit of the exits_set is accessible and if every populated component is reached by, at least, one exit.
+ *
+ * @return Function_Status: SUCCESS (1), INACCESSIBLE_EXIT (2) or UNREACHABLE_PEDESTRIANS (3).
+*/
+Function_Status verify_simulation_set_connectivity()
+{
+    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+    {
+        if(! is_exit_accessible(exits_set.list[exit_index]))
+            return INACCESSIBLE_EXIT;
+    }
+
+    if(component_labels == NULL)
+        return SUCCESS;
+
+    pthread_mutex_lock(&verification_lock);
+    verification_number++;
+    int num_reached_components = 0;
+
+    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+    {
+        Exit current_exit = exits_set.list[exit_index];
+
+        for(int cell_index = 0; cell_index < current_exit->width; cell_index++)
+        {
+            for(int j = -1; j < 2; j++)
+            {
+                for(int k = -1; k < 2; k++)
+                {
+                    int component_index = get_adjacent_component(current_exit->coordinates[cell_index], j, k);
+                    if(component_index == NO_COMPONENT || components[component_index].reached_mark == verification_number)
+                        continue;
+
+                    components[component_index].reached_mark = verification_number;
+                    if(components[component_index].is_populated)
+                        num_reached_components++;
+                }
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&verification_lock);
+
+    return num_reached_components == num_populated_components ? SUCCESS : UNREACHABLE_PEDESTRIANS;
+}
+
+/**
+ * Determines the smallest rectangle of the environment holding the cells of the exit and the components it reaches, outside
+ * of which its floor field doesn't propagate.
+ *
+ * @param current_exit The exit.
+ * @param first_cell Pointer to the Location where the top left corner of the rectangle will be stored.
+ * @param last_cell Pointer to the Location where the bottom right corner of the rectangle will be stored.
+*/
+void get_exit_region(Exit current_exit, Location *first_cell, Location *last_cell)
+{
+    if(component_labels == NULL)
+    {
+        *first_cell = (Location){0, 0};
+        *last_cell = (Location){cli_args.global_line_number - 1, cli_args.global_column_number - 1};
+        return;
+    }
+
+    *first_cell = current_exit->coordinates[0];
+    *last_cell = current_exit->coordinates[0];
+
+    for(int cell_index = 0; cell_index < current_exit->width; cell_index++)
+    {
+        Location exit_cell = current_exit->coordinates[cell_index];
+        expand_bounds(first_cell, last_cell, exit_cell, exit_cell);
+
+        for(int j = -1; j < 2; j++)
+        {
+            for(int k = -1; k < 2; k++)
+            {
+                int component_index = get_adjacent_component(exit_cell, j, k);
+                if(component_index != NO_COMPONENT)
+                    expand_bounds(first_cell, last_cell, components[component_index].first_cell, components[component_index].last_cell);
+            }
+        }
+    }
+}
+
+/**
+ * Deallocates the connected components of the environment.
+*/
+void deallocate_environment_components()
+{
+    free(component_labels);
+    free(components);
+    component_labels = NULL;
+    components = NULL;
+    num_components = 0;
+    num_populated_components = 0;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Labels, with a new component, the given free cell and every free cell reachable from it.
+ *
+ * @param first_cell A free cell not yet labeled.
+ * @param cell_queue Array with space for every cell of the environment, used as the queue of cells to be visited.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status label_component(Location first_cell, Location *cell_queue)
+{
+    if(num_components % 16 == 0)
+    {
+        environment_component *new_components = realloc(components, sizeof(environment_component) * (num_components + 16));
+        if(new_components == NULL)
+        {
+            fprintf(stderr, "Failure in the allocation of the connected components of the environment.\n");
+            return FAILURE;
+        }
+        components = new_components;
+    }
+
+    environment_component *component = &components[num_components];
+    *component = (environment_component) {first_cell, first_cell, false, 0};
+
+    size_t queue_start = 0, queue_end = 0;
+    component_labels[(size_t) first_cell.lin * cli_args.global_column_number + first_cell.col] = num_components;
+    cell_queue[queue_end++] = first_cell;
+
+    while(queue_start < queue_end)
+    {
+        Location current = cell_queue[queue_start++];
+        expand_bounds(&component->first_cell, &component->last_cell, current, current);
+
+        for(int j = -1; j < 2; j++)
+        {
+            for(int k = -1; k < 2; k++)
+            {
+                Location neighbor = {current.lin + j, current.col + k};
+                if(! is_within_grid_lines(neighbor.lin) || ! is_within_grid_columns(neighbor.col))
+                    continue;
+
+                int *neighbor_label = &component_labels[(size_t) neighbor.lin * cli_args.global_column_number + neighbor.col];
+                if(environment_only_grid[neighbor.lin][neighbor.col] == WALL_VALUE || *neighbor_label != NO_COMPONENT)
+                    continue;
+
+                if(j != 0 && k != 0 && ! is_diagonal_open(current, j, k))
+                    continue;
+
+                *neighbor_label = num_components;
+                cell_queue[queue_end++] = neighbor;
+            }
+        }
+    }
+
+    num_components++;
+
+    return SUCCESS;
+}
+
+/**
+ * Marks the populated components: those holding static pedestrians or, when the pedestrians are randomly placed, those holding
+ * any cell where a pedestrian may be placed.
+*/
+static void mark_populated_components()
+{
+    if(origin_uses_static_pedestrians() == true)
+    {
+        for(int pedestrian_index = 0; pedestrian_index < pedestrian_set.num_pedestrians; pedestrian_index++)
+        {
+            Location cell = pedestrian_set.list[pedestrian_index]->current;
+            components[component_labels[(size_t) cell.lin * cli_args.global_column_number + cell.col]].is_populated = true;
+        }
+    }
+    else
+    {
+        // The same cells considered by insert_pedestrians_at_random.
+        for(int i = 1; i < cli_args.global_line_number; i++)
+        {
+            for(int h = 1; h < cli_args.global_column_number; h++)
+            {
+                int component_index = component_labels[(size_t) i * cli_args.global_column_number + h];
+                if(component_index == NO_COMPONENT || (cli_args.varas_fig7 == true && (h == 1 || h == 2)))
+                    continue;
+
+                components[component_index].is_populated = true;
+            }
+        }
+    }
+
+    num_populated_components = 0;
+    for(int component_index = 0; component_index < num_components; component_index++)
+        num_populated_components += components[component_index].is_populated;
+}
+
+/**
+ * Determines the component of a neighbor of the given cell, if a pedestrian may move between them.
+ *
+ * @param cell A cell of the environment, such as an exit cell.
+ * @param line_offset Line of the neighbor relative to the cell (-1, 0 or 1).
+ * @param column_offset Column of the neighbor relative to the cell (-1, 0 or 1).
+ * @return The index of the component, or NO_COMPONENT if the neighbor is a wall, is outside the environment or its diagonal is blocked.
+*/
+static int get_adjacent_component(Location cell, int line_offset, int column_offset)
+{
+    Location neighbor = {cell.lin + line_offset, cell.col + column_offset};
+    if(! is_within_grid_lines(neighbor.lin) || ! is_within_grid_columns(neighbor.col))
+        return NO_COMPONENT;
+
+    if(line_offset != 0 && column_offset != 0 && ! is_diagonal_open(cell, line_offset, column_offset))
+        return NO_COMPONENT;
+
+    return component_labels[(size_t) neighbor.lin * cli_args.global_column_number + neighbor.col];
+}
+
+/**
+ * Verifies if a diagonal movement from the given cell isn't blocked by the walls and obstacles of the environment, following
+ * the same rules as is_diagonal_valid.
+ *
+ * @param cell Origin of the movement.
+ * @param line_offset Line of the diagonal neighbor relative to the cell (-1 or 1).
+ * @param column_offset Column of the diagonal neighbor relative to the cell (-1 or 1).
+ * @return bool, where True indicates that the diagonal is open and False otherwise.
+*/
+static bool is_diagonal_open(Location cell, int line_offset, int column_offset)
+{
+    bool is_vertical_blocked = environment_only_grid[cell.lin + line_offset][cell.col] == WALL_VALUE;
+    bool is_horizontal_blocked = environment_only_grid[cell.lin][cell.col + column_offset] == WALL_VALUE;
+
+    if(is_vertical_blocked && is_horizontal_blocked)
+        return false;
+
+    if(cli_args.prevent_corner_crossing && (is_vertical_blocked || is_horizontal_blocked))
+        return false;
+
+    return true;
+}
+
+/**
+ * Expands a rectangle of the environment so that it holds another rectangle.
+ *
+ * @param first_cell Top left corner of the rectangle to be expanded.
+ * @param last_cell Bottom right corner of the rectangle to be expanded.
+ * @param new_first_cell Top left corner of the rectangle to be held.
+ * @param new_last_cell Bottom right corner of the rectangle to be held.
+*/
+static void expand_bounds(Location *first_cell, Location *last_cell, Location new_first_cell, Location new_last_cell)
+{
+    if(new_first_cell.lin < first_cell->lin)
+        first_cell->lin = new_first_cell.lin;
+    if(new_first_cell.col < first_cell->col)
+        first_cell->col = new_first_cell.col;
+    if(new_last_cell.lin > last_cell->lin)
+        last_cell->lin = new_last_cell.lin;
+    if(new_last_cell.col > last_cell->col)
+        last_cell->col = new_last_cell.col;
+}
@@ -7,19 +7,112 @@
 
 #include<stdio.h>
 #include<stdlib.h>
+#include<stdint.h>
+#include<string.h>
 #include<stdbool.h>
+#include<time.h>
+#include<pthread.h>
 
 #include"../headers/exit.h"
 #include"../headers/grid.h"
 #include"../headers/cli_processing.h"
+#include"../headers/thread_pool.h"
+#include"../headers/connectivity.h"
 #include"../headers/shared_resources.h"
 
-Exits_Set exits_set = {NULL, NULL, 0};
+_Thread_local Exits_Set exits_set = {{PRECISION_DOUBLE, LAYOUT_ROW_MAJOR, 0, 0, 0, NULL}, NULL, 0};
+
+typedef struct{
+    Location *coordinates; // Cells of the exit, in the order they were provided. NULL for an empty slot of the cache.
+    int width;
+    Function_Status status; // SUCCESS or INACCESSIBLE_EXIT.
+    Field_Grid floor_field;
+}cached_floor_field;
+
+// Open addressing hash table, indexed by the cells of each exit. Its capacity is always a power of two.
+static cached_floor_field *floor_field_cache = NULL;
+static size_t floor_field_cache_capacity = 0;
+static size_t num_cached_floor_fields = 0;
+
+// Guards the floor field cache and the timing history, shared by the simulation sets prepared at the same time by the pipeline.
+static pthread_mutex_t floor_field_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+typedef struct{
+    Exit exit;
+    const cached_floor_field *base_field; // Cached floor field from which the floor field is repaired, or NULL.
+    cached_floor_field base_entry; // Copy of the cache entry of the base field, which a growth of the cache may move.
+    int *pending_exits; // Index, in the exits_set, of each exit whose floor field must be calculated. Shared by every task.
+    Function_Status status;
+    bool is_calculated;
+    double estimated_cost; // Cells of the region reached by the exit that the calculation is expected to visit.
+    double expected_seconds; // Estimated cost converted to seconds by the timing history.
+    double elapsed_seconds; // Time taken by the calculation.
+}exit_floor_field_task;
+
+typedef struct{
+    double total_seconds;
+    double total_cost; // Sum of the estimated costs of the timed calculations.
+}floor_field_timing;
+
+// Timing history of the floor fields calculated from scratch and of the repaired ones, which relates their estimated costs.
+static floor_field_timing calculation_timings[2] = {{0, 0}, {0, 0}};
+
+typedef struct{
+    Exits_Set *merged_exits; // The exits_set and wall_bitmap of the submitting thread, since the workers have their own.
+    Bit_Grid wall_bitmap;
+    Int_Grid final_floor_field; // Merged floor field, in floor field units.
+    int band_height; // Number of lines merged by each task.
+    Function_Status *band_status; // Status of the merge of each band.
+}merge_task_data;
+
+typedef struct{
+    int distance; // Floor field units of the cell when it was added to the frontier.
+    Location cell;
+}frontier_cell;
+
+typedef struct{
+    frontier_cell *cells; // Binary min-heap, ordered by distance.
+    size_t size;
+    size_t capacity;
+}frontier_heap;
+
+typedef struct{
+    Int_Grid floor_field;
+    unsigned char *valid_moves; // Bit mask, for each cell, of the neighbors to which the floor field propagates.
+    Location first_cell; // Top left corner of the region of the environment reached by the exit. 
+    Location last_cell; // Bottom right corner of the region of the environment reached by the exit.
+    int band_height; // Number of lines of valid_moves filled by each task.
+    frontier_cell *layer; // Cells of the frontier with the smallest distance, relaxed in parallel.
+    size_t layer_size;
+    size_t chunk_size; // Number of cells of the layer relaxed by each task.
+    frontier_cell *updates; // Neighbors lowered by each task, MAX_NEIGHBORS * chunk_size positions per task.
+    size_t *num_updates; // Number of neighbors lowered by each task.
+}frontier_task_data;
+
+#define MAX_NEIGHBORS 8
+#define FRONTIER_CHUNK_SIZE 1024
 
 static Exit create_new_exit(Location exit_coordinates);
-static Function_Status calculate_exit_floor_field(Exit s);
-static void initialize_exit_floor_field(Exit current_exit);
-static bool is_exit_accessible(Exit s);
+static Function_Status calculate_exits_floor_fields();
+static void calculate_exit_floor_field_task(void *task_data, int task_index);
+static void schedule_longest_tasks_first(exit_floor_field_task *tasks, int *pending_exits, int num_pending);
+static double estimate_exit_cost(Exit current_exit, const cached_floor_field *base_field);
+static void get_seconds_per_cost(double *seconds_per_cost);
+static void record_calculation_timings(exit_floor_field_task *tasks, int *pending_exits, int num_pending);
+static void merge_floor_field_band(void *task_data, int task_index);
+static Function_Status insert_cached_floor_field(Exit current_exit, Function_Status status);
+static cached_floor_field *find_cache_slot(cached_floor_field *cache, size_t capacity, Location *coordinates, int width);
+static Function_Status grow_floor_field_cache();
+static Function_Status calculate_exit_floor_field(Exit current_exit, const cached_floor_field *base_field);
+static Function_Status propagate_exit_floor_field(Exit current_exit, Int_Grid floor_field);
+static void fill_valid_moves_band(void *task_data, int task_index);
+static void relax_frontier_chunk(void *task_data, int task_index);
+static Function_Status push_frontier_cell(frontier_heap *heap, frontier_cell new_cell);
+static frontier_cell pop_frontier_cell(frontier_heap *heap);
+static Function_Status repair_exit_floor_field(Exit current_exit, const cached_floor_field *base_field, Int_Grid floor_field);
+static const cached_floor_field *find_cached_subset(Exit current_exit);
+static void initialize_exit_floor_field(Exit current_exit, Int_Grid floor_field);
+static bool is_exit_cell(Exit current_exit, Location cell);
 
 /**
  * Adds a new exit to the exits set.
@@ -75,9 +168,12 @@ Function_Status expand_exit(Exit original_exit, Location new_coordinates)
 
 
 /**
- * Merge the floor_fields of all the exits in the exits_set. The result of this merge is stored at exits_set.final_floor_field.
+ * Merge the floor_fields of all the exits in the exits_set. The result of this merge is stored at exits_set.final_floor_field,
+ * and its walls and obstacles are marked in the wall_bitmap.
  * 
- * @return Function_Status: FAILURE (0), SUCCESS (1) or INACCESSIBLE_EXIT(2).
+ * @note The simulation set is verified against the connected components of the environment before any floor field is calculated.
+ * 
+ * @return Function_Status: FAILURE (0), SUCCESS (1), INACCESSIBLE_EXIT(2) or UNREACHABLE_PEDESTRIANS (3).
 */
 Function_Status calculate_final_floor_field()
 {
@@ -87,40 +183,144 @@ Function_Status calculate_final_floor_field()
         return FAILURE;
     }
 
-    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+    Function_Status returned_status = verify_simulation_set_connectivity();
+    if(returned_status != SUCCESS)
+        return returned_status;
+
+    if(verify_field_units_range() == FAILURE)
+        return FAILURE;
+
+    returned_status = calculate_exits_floor_fields();
+    if(returned_status != SUCCESS)
+        return returned_status;
+
+    Int_Grid final_floor_field = allocate_integer_grid(cli_args.global_line_number, cli_args.global_column_number);
+    exits_set.final_floor_field = allocate_field_grid(cli_args.global_line_number, cli_args.global_column_number, cli_args.field_precision, cli_args.grid_layout);
+    if(final_floor_field == NULL || exits_set.final_floor_field.cells == NULL)
     {
-        Function_Status returned_status = calculate_exit_floor_field(exits_set.list[exit_index]);
-        if(returned_status != SUCCESS )
-            return returned_status;
+        fprintf(stderr,"Failure during the allocation of the final_floor_field.\n");
+        deallocate_grid((void **) final_floor_field, cli_args.global_line_number);
+        return FAILURE;
     }
 
-    exits_set.final_floor_field = allocate_double_grid(cli_args.global_line_number, cli_args.global_column_number);
-    if(exits_set.final_floor_field == NULL)
+    if( reset_bit_grid(wall_bitmap, cli_args.global_line_number, cli_args.global_column_number) == FAILURE)
     {
-        fprintf(stderr,"Failure during the allocation of the final_floor_field.\n");
+        deallocate_grid((void **) final_floor_field, cli_args.global_line_number);
         return FAILURE;
     }
 
-    if( reset_double_grid(exits_set.final_floor_field, cli_args.global_line_number, cli_args.global_column_number) == FAILURE)
+    // The lines are merged in bands, whose height is a multiple of the tile side, distributed among the threads.
+    int tile_side = 1 << TILE_SIDE_BITS;
+    int num_bands = is_thread_pool_active() ? get_thread_pool_size() * 4 : 1;
+    int band_height = (cli_args.global_line_number + num_bands - 1) / num_bands;
+    band_height = (band_height + tile_side - 1) / tile_side * tile_side;
+    num_bands = (cli_args.global_line_number + band_height - 1) / band_height;
+
+    merge_task_data merge_data = {&exits_set, wall_bitmap, final_floor_field, band_height, malloc(sizeof(Function_Status) * num_bands)};
+    if(merge_data.band_status == NULL)
+    {
+        fprintf(stderr,"Failure during the allocation of the final_floor_field.\n");
+        deallocate_grid((void **) final_floor_field, cli_args.global_line_number);
         return FAILURE;
+    }
+
+    run_parallel_tasks(merge_floor_field_band, &merge_data, num_bands);
+
+    for(int band_index = 0; band_index < num_bands && returned_status == SUCCESS; band_index++)
+        returned_status = merge_data.band_status[band_index];
+
+    free(merge_data.band_status);
+    deallocate_grid((void **) final_floor_field, cli_args.global_line_number);
+
+    return returned_status;
+}
 
-    Double_Grid current_exit = exits_set.list[0]->floor_field;
-    copy_double_grid(exits_set.final_floor_field, current_exit); // uses the first exit as the base for the merging
-    
-    for(int exit_index = 1; exit_index < exits_set.num_exits; exit_index++)
+/**
+ * Estimates the seconds that calculate_final_floor_field will take for the exits_set, used to order the simulation sets prepared
+ * at the same time by the pipeline.
+ *
+ * @note Each exit not in the floor field cache costs the area of the region it reaches, or the share of new cells of that area if
+ * its floor field is repaired, converted to seconds by the timing history. Cached exits cost nothing. The merge of the floor
+ * fields, which visits every cell of the environment for each exit, is left out.
+ *
+ * @return The estimated seconds.
+*/
+double estimate_final_floor_field_seconds()
+{
+    double seconds_per_cost[2];
+    get_seconds_per_cost(seconds_per_cost);
+
+    double expected_seconds = 0;
+    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
     {
-        current_exit = exits_set.list[exit_index]->floor_field;
-        for(int i = 0; i < cli_args.global_line_number; i++)
+        Exit current_exit = exits_set.list[exit_index];
+        const cached_floor_field *base_field = NULL;
+        cached_floor_field base_entry;
+
+        pthread_mutex_lock(&floor_field_cache_lock);
+        if(cli_args.use_floor_field_cache && floor_field_cache != NULL)
         {
-            for(int h = 0; h < cli_args.global_column_number; h++)
+            if(find_cache_slot(floor_field_cache, floor_field_cache_capacity, current_exit->coordinates, current_exit->width)->coordinates != NULL)
             {
-                if(exits_set.final_floor_field[i][h] > current_exit[i][h])
-                    exits_set.final_floor_field[i][h] = current_exit[i][h];
+                pthread_mutex_unlock(&floor_field_cache_lock);
+                continue;
+            }
+
+            base_field = find_cached_subset(current_exit);
+            if(base_field != NULL)
+            {
+                base_entry = *base_field;
+                base_field = &base_entry;
             }
         }
+        pthread_mutex_unlock(&floor_field_cache_lock);
+
+        expected_seconds += estimate_exit_cost(current_exit, base_field) * seconds_per_cost[base_field != NULL];
     }
 
-    return SUCCESS;
+    return expected_seconds;
+}
+
+/**
+ * Verify if the given exit is accessible.
+ * 
+ * @note A exit is accessible if there is, at least, one adjacent empty cell in the vertical or horizontal directions. 
+ * 
+ * @param current_exit The exit that will be verified.
+ * @return bool, where True indicates tha the given exit is accessible, or False otherwise.
+*/
+bool is_exit_accessible(Exit current_exit)
+{
+    if(current_exit == NULL)
+        return false;
+
+    for(int exit_cell_index = 0; exit_cell_index < current_exit->width; exit_cell_index++)
+    {
+        Location c = current_exit->coordinates[exit_cell_index];
+
+        for(int j = -1; j < 2; j++)
+        {
+            if(! is_within_grid_lines(c.lin + j))
+                continue;
+
+            for(int k = -1; k < 2; k++)
+            {
+                if(! is_within_grid_columns(c.col + k))
+                    continue;
+
+                if(environment_only_grid[c.lin + j][c.col + k] == WALL_VALUE || 
+                   is_exit_cell(current_exit, (Location){c.lin + j, c.col + k}))
+                    continue;
+
+                if(j != 0 && k != 0)
+                    continue; // diagonals
+
+                return true;
+            }
+        }
+    }
+
+    return false;
 }
 
 /**
@@ -133,19 +333,60 @@ void deallocate_exits()
         Exit current = exits_set.list[exit_index];
 
         free(current->coordinates);
-        deallocate_grid((void **) current->floor_field, cli_args.global_line_number);
+        if(! current->is_floor_field_cached)
+            deallocate_field_grid(&current->floor_field);
         free(current);
     }
 
     free(exits_set.list);
     exits_set.list = NULL;
 
-    deallocate_grid((void **) exits_set.final_floor_field, cli_args.global_line_number);
-    exits_set.final_floor_field = NULL;
+    deallocate_field_grid(&exits_set.final_floor_field);
 
     exits_set.num_exits = 0;
 }
 
+/**
+ * Deallocates the floor fields of the exits of the exits set and its final floor field, keeping the exits, so that they can be
+ * calculated again.
+*/
+void deallocate_floor_fields()
+{
+    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+    {
+        Exit current = exits_set.list[exit_index];
+
+        if(! current->is_floor_field_cached)
+            deallocate_field_grid(&current->floor_field);
+        current->floor_field = (Field_Grid) {cli_args.field_precision, cli_args.grid_layout, 0, 0, 0, NULL};
+        current->is_floor_field_cached = false;
+    }
+
+    deallocate_field_grid(&exits_set.final_floor_field);
+}
+
+/**
+ * Deallocates the floor fields kept by the floor field cache, as well as the cache itself.
+ *
+ * @note Must only be called after the exits that use cached floor fields are deallocated.
+*/
+void deallocate_floor_field_cache()
+{
+    for(size_t slot = 0; slot < floor_field_cache_capacity; slot++)
+    {
+        if(floor_field_cache[slot].coordinates == NULL)
+            continue;
+
+        free(floor_field_cache[slot].coordinates);
+        deallocate_field_grid(&floor_field_cache[slot].floor_field);
+    }
+
+    free(floor_field_cache);
+    floor_field_cache = NULL;
+    floor_field_cache_capacity = 0;
+    num_cached_floor_fields = 0;
+}
+
 /* ---------------- ---------------- ---------------- ---------------- ---------------- */
 /* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
 /* ---------------- ---------------- ---------------- ---------------- ---------------- */
@@ -170,7 +411,8 @@ static Exit create_new_exit(Location exit_coordinates)
             new_exit->coordinates[0] = exit_coordinates;
             new_exit->width = 1;
 
-            new_exit->floor_field = allocate_double_grid(cli_args.global_line_number, cli_args.global_column_number);
+            new_exit->floor_field = (Field_Grid) {cli_args.field_precision, cli_args.grid_layout, 0, 0, 0, NULL}; // Allocated when calculated.
+            new_exit->is_floor_field_cached = false;
         }
 
         return new_exit;
@@ -179,13 +421,427 @@ static Exit create_new_exit(Location exit_coordinates)
     return NULL;
 }
 
+/**
+ * Calculates the floor field of every exit of the exits_set. The floor fields are independent, so they are calculated in
+ * parallel when the thread pool is active, the most expensive ones first. 
+ * 
+ * @note With --floor-field-cache, the floor field of an exit already calculated is taken from the cache, and the calculated
+ * floor fields are added to it. Inaccessible exits are cached as well. When a cached exit is formed by a subset of the cells of
+ * an exit, as when a door is widened, its floor field is repaired from the new cells instead of calculated from scratch.
+ *
+ * @return Function_Status: FAILURE (0), SUCCESS (1) or INACCESSIBLE_EXIT(2), for the first exit, in the exits_set order, whose
+ * floor field couldn't be obtained.
+*/
+static Function_Status calculate_exits_floor_fields()
+{
+    exit_floor_field_task *tasks = malloc(sizeof(exit_floor_field_task) * exits_set.num_exits);
+    int *pending_exits = malloc(sizeof(int) * exits_set.num_exits);
+    if(tasks == NULL || pending_exits == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of the floor field calculation tasks.\n");
+        free(tasks);
+        free(pending_exits);
+        return FAILURE;
+    }
+
+    int num_pending = 0;
+    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+    {
+        Exit current_exit = exits_set.list[exit_index];
+        exit_floor_field_task *task = &tasks[exit_index];
+        *task = (exit_floor_field_task) {current_exit, NULL, {NULL, 0, SUCCESS, {0}}, pending_exits, SUCCESS, false, 0, 0, 0};
+
+        pthread_mutex_lock(&floor_field_cache_lock);
+        if(cli_args.use_floor_field_cache && floor_field_cache != NULL)
+        {
+            cached_floor_field *slot = find_cache_slot(floor_field_cache, floor_field_cache_capacity, current_exit->coordinates, current_exit->width);
+            if(slot->coordinates != NULL)
+            {
+                current_exit->floor_field = slot->floor_field;
+                current_exit->is_floor_field_cached = true;
+                task->status = slot->status;
+                pthread_mutex_unlock(&floor_field_cache_lock);
+                continue;
+            }
+
+            const cached_floor_field *base_field = find_cached_subset(current_exit);
+            if(base_field != NULL)
+            {
+                task->base_entry = *base_field;
+                task->base_field = &task->base_entry;
+            }
+        }
+        pthread_mutex_unlock(&floor_field_cache_lock);
+
+        pending_exits[num_pending++] = exit_index;
+    }
+
+    if(is_thread_pool_active())
+    {
+        schedule_longest_tasks_first(tasks, pending_exits, num_pending);
+        run_parallel_tasks(calculate_exit_floor_field_task, tasks, num_pending);
+        record_calculation_timings(tasks, pending_exits, num_pending);
+    }
+    else
+    {
+        for(int pending_index = 0; pending_index < num_pending; pending_index++)
+        {
+            calculate_exit_floor_field_task(tasks, pending_index);
+            if(tasks[pending_exits[pending_index]].status != SUCCESS)
+                break; // The remaining exits are irrelevant.
+        }
+    }
+
+    Function_Status returned_status = SUCCESS;
+    pthread_mutex_lock(&floor_field_cache_lock);
+    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+    {
+        exit_floor_field_task *task = &tasks[exit_index];
+
+        if(cli_args.use_floor_field_cache && task->is_calculated && task->status != FAILURE && 
+           insert_cached_floor_field(task->exit, task->status) == FAILURE)
+            task->status = FAILURE;
+
+        if(returned_status == SUCCESS && (task->is_calculated || task->exit->is_floor_field_cached))
+            returned_status = task->status;
+    }
+    pthread_mutex_unlock(&floor_field_cache_lock);
+
+    free(tasks);
+    free(pending_exits);
+
+    return returned_status;
+}
+
+/**
+ * Calculates the floor field of a pending exit. Used as a task of the thread pool.
+ *
+ * @param task_data Array with the task of each exit of the exits_set.
+ * @param task_index Index of the pending exit, among the pending exits.
+*/
+static void calculate_exit_floor_field_task(void *task_data, int task_index)
+{
+    exit_floor_field_task *tasks = task_data;
+    exit_floor_field_task *task = &tasks[tasks[0].pending_exits[task_index]];
+
+    struct timespec start_time, end_time;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+    task->status = calculate_exit_floor_field(task->exit, task->base_field);
+    task->is_calculated = true;
+
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    task->elapsed_seconds = (end_time.tv_sec - start_time.tv_sec) + (end_time.tv_nsec - start_time.tv_nsec) / 1e9;
+}
+
+/**
+ * Orders the pending exits by the expected time of their floor fields, longest first, so that the most expensive calculations
+ * aren't left to the end of the group while the other threads are idle. The threads take the next pending exit as they finish
+ * the previous one, so the shorter calculations fill the gaps.
+ *
+ * @note The timing history of each kind of calculation converts the estimated costs to seconds, so floor fields calculated from
+ * scratch and repaired ones can be compared.
+ *
+ * @param tasks The task of each exit of the exits_set.
+ * @param pending_exits Index, in the exits_set, of each exit whose floor field must be calculated, which is reordered.
+ * @param num_pending Number of pending exits.
+*/
+static void schedule_longest_tasks_first(exit_floor_field_task *tasks, int *pending_exits, int num_pending)
+{
+    double seconds_per_cost[2];
+    get_seconds_per_cost(seconds_per_cost);
+
+    for(int pending_index = 0; pending_index < num_pending; pending_index++)
+    {
+        exit_floor_field_task *task = &tasks[pending_exits[pending_index]];
+
+        task->estimated_cost = estimate_exit_cost(task->exit, task->base_field);
+        task->expected_seconds = task->estimated_cost * seconds_per_cost[task->base_field != NULL];
+    }
+
+    // Insertion sort, since the exits of a simulation set are few.
+    for(int pending_index = 1; pending_index < num_pending; pending_index++)
+    {
+        int exit_index = pending_exits[pending_index];
+        int insertion_index = pending_index;
+
+        while(insertion_index > 0 && tasks[pending_exits[insertion_index - 1]].expected_seconds < tasks[exit_index].expected_seconds)
+        {
+            pending_exits[insertion_index] = pending_exits[insertion_index - 1];
+            insertion_index--;
+        }
+
+        pending_exits[insertion_index] = exit_index;
+    }
+}
+
+/**
+ * Adds the calculated floor fields to the timing history of their kind of calculation.
+ *
+ * @param tasks The task of each exit of the exits_set.
+ * @param pending_exits Index, in the exits_set, of each exit whose floor field was calculated.
+ * @param num_pending Number of pending exits.
+*/
+static void record_calculation_timings(exit_floor_field_task *tasks, int *pending_exits, int num_pending)
+{
+    pthread_mutex_lock(&floor_field_cache_lock);
+    for(int pending_index = 0; pending_index < num_pending; pending_index++)
+    {
+        exit_floor_field_task *task = &tasks[pending_exits[pending_index]];
+        if(task->status != SUCCESS)
+            continue; // Inaccessible exits are found without propagating their floor fields.
+
+        floor_field_timing *timing = &calculation_timings[task->base_field != NULL];
+        timing->total_cost += task->estimated_cost;
+        timing->total_seconds += task->elapsed_seconds;
+    }
+    pthread_mutex_unlock(&floor_field_cache_lock);
+}
+
+/**
+ * Estimates the cells that the calculation of the floor field of an exit is expected to visit.
+ *
+ * @note The cost of a floor field calculated from scratch is the area of the region reached by the exit. A repaired floor field
+ * only visits the cells closer to its new exit cells, estimated as the share of new cells of that area.
+ *
+ * @param current_exit The exit.
+ * @param base_field Cached floor field from which the floor field is repaired, or NULL.
+ * @return The estimated cost.
+*/
+static double estimate_exit_cost(Exit current_exit, const cached_floor_field *base_field)
+{
+    Location first_cell, last_cell;
+    get_exit_region(current_exit, &first_cell, &last_cell);
+    double estimated_cost = (double) (last_cell.lin - first_cell.lin + 1) * (last_cell.col - first_cell.col + 1);
+
+    if(base_field != NULL)
+        estimated_cost *= (double) (current_exit->width - base_field->width) / current_exit->width;
+
+    return estimated_cost;
+}
+
+/**
+ * Obtains, from the timing history, the seconds taken by each unit of estimated cost of the floor fields calculated from scratch
+ * (index 0) and of the repaired ones (index 1). A kind without history borrows the rate of the other.
+ *
+ * @param seconds_per_cost Array of two elements, where the rates will be stored.
+*/
+static void get_seconds_per_cost(double *seconds_per_cost)
+{
+    pthread_mutex_lock(&floor_field_cache_lock);
+    for(int kind = 0; kind < 2; kind++)
+    {
+        floor_field_timing *timing = &calculation_timings[kind];
+        floor_field_timing *other_timing = &calculation_timings[! kind];
+
+        if(timing->total_cost > 0)
+            seconds_per_cost[kind] = timing->total_seconds / timing->total_cost;
+        else if(other_timing->total_cost > 0)
+            seconds_per_cost[kind] = other_timing->total_seconds / other_timing->total_cost;
+        else
+            seconds_per_cost[kind] = 1;
+    }
+    pthread_mutex_unlock(&floor_field_cache_lock);
+}
+
+/**
+ * Merges the floor fields of the exits in a band of lines of the final floor field, marking its walls and obstacles in the 
+ * wall_bitmap. Used as a task of the thread pool.
+ *
+ * @param task_data The merge_task_data of the final floor field.
+ * @param task_index Index of the band.
+*/
+static void merge_floor_field_band(void *task_data, int task_index)
+{
+    merge_task_data *merge_data = task_data;
+    Exits_Set *merged_exits = merge_data->merged_exits;
+    Int_Grid final_floor_field = merge_data->final_floor_field;
+
+    int first_line = task_index * merge_data->band_height;
+    int end_line = first_line + merge_data->band_height;
+    if(end_line > cli_args.global_line_number)
+        end_line = cli_args.global_line_number;
+
+    for(int i = first_line; i < end_line; i++)
+    {
+        for(int h = 0; h < cli_args.global_column_number; h++)
+        {
+            final_floor_field[i][h] = get_field_units(merged_exits->list[0]->floor_field, i, h); // uses the first exit as the base for the merging
+            
+            for(int exit_index = 1; exit_index < merged_exits->num_exits; exit_index++)
+            {
+                int current_exit_value = get_field_units(merged_exits->list[exit_index]->floor_field, i, h);
+                if(final_floor_field[i][h] > current_exit_value)
+                    final_floor_field[i][h] = current_exit_value;
+            }
+        }
+    }
+
+    merge_data->band_status[task_index] = store_field_lines(merged_exits->final_floor_field, final_floor_field, first_line, end_line);
+    if(merge_data->band_status[task_index] == FAILURE)
+        return;
+
+    for(int i = first_line; i < end_line; i++)
+    {
+        for(int h = 0; h < cli_args.global_column_number; h++)
+        {
+            if(is_field_wall(merged_exits->final_floor_field, i, h))
+                set_grid_bit(merge_data->wall_bitmap, (Location){i, h});
+        }
+    }
+}
+
+/**
+ * Adds the floor field of the given exit to the floor field cache, which becomes its owner. If an exit with the same cells was
+ * cached in the meantime, the floor field of the given exit is replaced by the cached one.
+ *
+ * @param current_exit Exit whose floor field was calculated.
+ * @param status Status of the calculation: SUCCESS or INACCESSIBLE_EXIT.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status insert_cached_floor_field(Exit current_exit, Function_Status status)
+{
+    if(2 * (num_cached_floor_fields + 1) > floor_field_cache_capacity && grow_floor_field_cache() == FAILURE)
+        return FAILURE;
+
+    cached_floor_field *slot = find_cache_slot(floor_field_cache, floor_field_cache_capacity, current_exit->coordinates, current_exit->width);
+    if(slot->coordinates != NULL) // The same exit appears more than once in the simulation set.
+    {
+        deallocate_field_grid(&current_exit->floor_field);
+        current_exit->floor_field = slot->floor_field;
+        current_exit->is_floor_field_cached = true;
+        return SUCCESS;
+    }
+
+    Location *coordinates = malloc(sizeof(Location) * current_exit->width);
+    if(coordinates == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of an entry of the floor field cache.\n");
+        return FAILURE;
+    }
+    memcpy(coordinates, current_exit->coordinates, sizeof(Location) * current_exit->width);
+
+    *slot = (cached_floor_field) {coordinates, current_exit->width, status, current_exit->floor_field};
+    num_cached_floor_fields++;
+
+    current_exit->is_floor_field_cached = true;
+
+    return SUCCESS;
+}
+
+/**
+ * Finds, in the floor field cache, the accessible exit with the most cells among those formed only by cells of the given exit.
+ *
+ * @param current_exit Exit whose cells may contain a cached exit.
+ * @return Pointer to the cache entry of the found exit, or NULL if no cached exit is formed by a subset of the cells.
+*/
+static const cached_floor_field *find_cached_subset(Exit current_exit)
+{
+    const cached_floor_field *subset = NULL;
+
+    for(size_t slot = 0; slot < floor_field_cache_capacity; slot++)
+    {
+        const cached_floor_field *entry = &floor_field_cache[slot];
+        if(entry->coordinates == NULL || entry->status != SUCCESS || entry->width >= current_exit->width)
+            continue;
+
+        if(subset != NULL && entry->width <= subset->width)
+            continue;
+
+        bool is_subset = true;
+        for(int entry_cell = 0; entry_cell < entry->width && is_subset; entry_cell++)
+        {
+            is_subset = false;
+            for(int exit_cell = 0; exit_cell < current_exit->width; exit_cell++)
+            {
+                if(entry->coordinates[entry_cell].lin == current_exit->coordinates[exit_cell].lin &&
+                   entry->coordinates[entry_cell].col == current_exit->coordinates[exit_cell].col)
+                {
+                    is_subset = true;
+                    break;
+                }
+            }
+        }
+
+        if(is_subset)
+            subset = entry;
+    }
+
+    return subset;
+}
+
+/**
+ * Finds the slot of the floor field cache that holds the exit formed by the given cells or, if the exit isn't cached, the empty
+ * slot where it would be stored.
+ *
+ * @param cache The slots of the cache.
+ * @param capacity Number of slots of the cache, a power of two with at least one empty slot.
+ * @param coordinates Cells of the exit.
+ * @param width Number of cells of the exit.
+ * @return Pointer to the found slot.
+*/
+static cached_floor_field *find_cache_slot(cached_floor_field *cache, size_t capacity, Location *coordinates, int width)
+{
+    uint64_t hash = 14695981039346656037ULL; // FNV-1a hash of the cells.
+    for(int cell_index = 0; cell_index < width; cell_index++)
+    {
+        hash = (hash ^ (uint32_t) coordinates[cell_index].lin) * 1099511628211ULL;
+        hash = (hash ^ (uint32_t) coordinates[cell_index].col) * 1099511628211ULL;
+    }
+
+    for(size_t slot = hash & (capacity - 1); ; slot = (slot + 1) & (capacity - 1))
+    {
+        if(cache[slot].coordinates == NULL)
+            return &cache[slot];
+
+        if(cache[slot].width == width && memcmp(cache[slot].coordinates, coordinates, sizeof(Location) * width) == 0)
+            return &cache[slot];
+    }
+}
+
+/**
+ * Doubles the capacity of the floor field cache, moving the cached floor fields to their new slots.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status grow_floor_field_cache()
+{
+    size_t new_capacity = floor_field_cache_capacity > 0 ? floor_field_cache_capacity * 2 : 64;
+
+    cached_floor_field *new_cache = calloc(new_capacity, sizeof(cached_floor_field));
+    if(new_cache == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of the floor field cache.\n");
+        return FAILURE;
+    }
+
+    for(size_t slot = 0; slot < floor_field_cache_capacity; slot++)
+    {
+        cached_floor_field *entry = &floor_field_cache[slot];
+        if(entry->coordinates != NULL)
+            *find_cache_slot(new_cache, new_capacity, entry->coordinates, entry->width) = *entry;
+    }
+
+    free(floor_field_cache);
+    floor_field_cache = new_cache;
+    floor_field_cache_capacity = new_capacity;
+
+    return SUCCESS;
+}
+
 /**
  * Calculates the floor field for the given exit.
  * 
+ * @note The calculation is done on integer grids, in units of 1 / diagonal_denominator, so every value is exact and the 
+ * result doesn't depend on the order in which the cells are processed. The result is then stored in the exit floor field 
+ * with the precision selected by --field-precision.
+ * 
  * @param current_exit Exit for which the floor field will be calculated.
+ * @param base_field Cached floor field of an accessible exit formed by a subset of the cells of current_exit, from which the
+ * floor field is repaired instead of calculated from scratch, or NULL.
  * @return Function_Status: FAILURE (0), SUCCESS (1) or INACCESSIBLE_EXIT(2).
 */
-static Function_Status calculate_exit_floor_field(Exit current_exit)
+static Function_Status calculate_exit_floor_field(Exit current_exit, const cached_floor_field *base_field)
 {
     if(current_exit == NULL)
     {
@@ -193,103 +849,464 @@ static Function_Status calculate_exit_floor_field(Exit current_exit)
         return FAILURE;
     }
 
-    double floor_field_rule[][3] = 
-                    {{cli_args.diagonal, 1.0, cli_args.diagonal},
-                     {       1.0,        0.0,        1.0       },
-                     {cli_args.diagonal, 1.0, cli_args.diagonal}};
+    Int_Grid floor_field = allocate_integer_grid(cli_args.global_line_number,cli_args.global_column_number);
+    if(floor_field == NULL)
+    {
+        fprintf(stderr, "Failure to allocate the floor_field at calculate_exit_floor_field.\n");
+        return FAILURE;
+    }
 
-    initialize_exit_floor_field(current_exit);
+    initialize_exit_floor_field(current_exit, floor_field);
 
     if(is_exit_accessible(current_exit) == false)
+    {
+        deallocate_grid((void **) floor_field, cli_args.global_line_number);
         return INACCESSIBLE_EXIT;
+    }
+
+    Function_Status returned_status;
+    if(base_field != NULL)
+        returned_status = repair_exit_floor_field(current_exit, base_field, floor_field);
+    else
+        returned_status = propagate_exit_floor_field(current_exit, floor_field);
+
+    if(returned_status == SUCCESS)
+    {
+        current_exit->floor_field = allocate_field_grid(cli_args.global_line_number, cli_args.global_column_number, cli_args.field_precision, cli_args.grid_layout);
+        if(current_exit->floor_field.cells == NULL)
+        {
+            fprintf(stderr, "Failure during the allocation of the floor field of an exit.\n");
+            returned_status = FAILURE;
+        }
+        else
+            returned_status = store_field_grid(current_exit->floor_field, floor_field);
+    }
+
+    deallocate_grid((void **) floor_field, cli_args.global_line_number);
+
+    return returned_status;
+}
 
-    Double_Grid floor_field = current_exit->floor_field;
-    Double_Grid auxiliary_grid = allocate_double_grid(cli_args.global_line_number,cli_args.global_column_number);
-    // stores the chances for the timestep t + 1
-    
-    if(auxiliary_grid == NULL)
+/**
+ * Propagates the floor field from the exit cells until every accessible cell holds its distance to the exit. The cells are 
+ * settled in layers of increasing distance, taken from a frontier: the cells of each layer are relaxed in parallel, in chunks,
+ * and each neighbor is lowered with an atomic minimum, so the result is the same shortest distance as a sequential propagation.
+ * 
+ * @note The cells to which each cell propagates are determined before the propagation, since the walls never change, so the 
+ * tasks only access the floor field through atomic operations.
+ * 
+ * @param current_exit Exit whose cells start the propagation.
+ * @param floor_field Integer grid, in floor field units, initialized with the walls and the exit cells.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status propagate_exit_floor_field(Exit current_exit, Int_Grid floor_field)
+{
+    int exit_units = EXIT_VALUE * cli_args.diagonal_denominator;
+    size_t num_cells = (size_t) cli_args.global_line_number * cli_args.global_column_number;
+
+    frontier_task_data data = {floor_field, NULL, {0, 0}, {0, 0}, 0, NULL, 0, 0, NULL, NULL};
+    frontier_heap frontier = {NULL, 0, 0};
+    size_t layer_capacity = 0;
+    Function_Status returned_status = SUCCESS;
+
+    data.valid_moves = malloc(sizeof(unsigned char) * num_cells);
+    if(data.valid_moves == NULL)
     {
-        fprintf(stderr, "Failure to allocate the auxiliary_grid at calculate_exit_floor_field.\n");
+        fprintf(stderr, "Failure in the allocation of the valid moves used to propagate a floor field.\n");
         return FAILURE;
     }
 
-    copy_double_grid(auxiliary_grid, floor_field); // copies the base structure of the floor field
+    // Cells outside the region are never reached, so their valid moves aren't needed.
+    get_exit_region(current_exit, &data.first_cell, &data.last_cell);
+    int num_lines = data.last_cell.lin - data.first_cell.lin + 1;
 
-    bool has_changed;
-    do
+    int num_bands = is_thread_pool_active() ? get_thread_pool_size() * 4 : 1;
+    data.band_height = (num_lines + num_bands - 1) / num_bands;
+    num_bands = (num_lines + data.band_height - 1) / data.band_height;
+    run_parallel_tasks(fill_valid_moves_band, &data, num_bands);
+
+    for(int cell_index = 0; cell_index < current_exit->width && returned_status == SUCCESS; cell_index++)
+        returned_status = push_frontier_cell(&frontier, (frontier_cell){exit_units, current_exit->coordinates[cell_index]});
+
+    while(frontier.size > 0 && returned_status == SUCCESS)
     {
-        has_changed = false;
-        for(int i = 0; i < cli_args.global_line_number; i++)
+        // Takes every cell of the frontier with the smallest distance, which is final.
+        int layer_distance = frontier.cells[0].distance;
+        data.layer_size = 0;
+        while(frontier.size > 0 && frontier.cells[0].distance == layer_distance)
         {
-            for(int h = 0; h < cli_args.global_column_number; h++)
+            if(data.layer_size == layer_capacity)
             {
-                double current_cell_value = floor_field[i][h];
+                size_t new_capacity = layer_capacity == 0 ? FRONTIER_CHUNK_SIZE : layer_capacity * 2;
+                frontier_cell *new_layer = realloc(data.layer, sizeof(frontier_cell) * new_capacity);
+                size_t *new_num_updates = realloc(data.num_updates, sizeof(size_t) * (new_capacity / FRONTIER_CHUNK_SIZE));
+                frontier_cell *new_updates = realloc(data.updates, sizeof(frontier_cell) * new_capacity * MAX_NEIGHBORS);
+                if(new_layer != NULL)
+                    data.layer = new_layer;
+                if(new_num_updates != NULL)
+                    data.num_updates = new_num_updates;
+                if(new_updates != NULL)
+                    data.updates = new_updates;
+
+                if(new_layer == NULL || new_num_updates == NULL || new_updates == NULL)
+                {
+                    fprintf(stderr, "Failure in the allocation of the frontier layer used to propagate a floor field.\n");
+                    returned_status = FAILURE;
+                    break;
+                }
+                layer_capacity = new_capacity;
+            }
+
+            data.layer[data.layer_size++] = pop_frontier_cell(&frontier);
+        }
+
+        if(returned_status == FAILURE)
+            break;
+
+        int num_chunks = (int) ((data.layer_size + FRONTIER_CHUNK_SIZE - 1) / FRONTIER_CHUNK_SIZE);
+        data.chunk_size = FRONTIER_CHUNK_SIZE;
+        run_parallel_tasks(relax_frontier_chunk, &data, num_chunks);
+
+        // Only the last value stored in each cell is added to the frontier.
+        for(int chunk_index = 0; chunk_index < num_chunks && returned_status == SUCCESS; chunk_index++)
+        {
+            frontier_cell *chunk_updates = data.updates + (size_t) chunk_index * FRONTIER_CHUNK_SIZE * MAX_NEIGHBORS;
+
+            for(size_t update_index = 0; update_index < data.num_updates[chunk_index]; update_index++)
+            {
+                frontier_cell update = chunk_updates[update_index];
+                if(floor_field[update.cell.lin][update.cell.col] != update.distance)
+                    continue;
+
+                returned_status = push_frontier_cell(&frontier, update);
+                if(returned_status == FAILURE)
+                    break;
+            }
+        }
+    }
+
+    free(data.valid_moves);
+    free(data.layer);
+    free(data.updates);
+    free(data.num_updates);
+    free(frontier.cells);
+
+    return returned_status;
+}
+
+/**
+ * Repairs the cached floor field of an exit formed by a subset of the cells of the given exit, obtaining the floor field of the
+ * given exit. Since the new exit cells can only shorten the distances, the cached values are upper bounds and only the cells whose
+ * distance decreases, starting from the new exit cells, must be updated. The result is identical to propagate_exit_floor_field.
+ * 
+ * @param current_exit Exit for which the floor field will be obtained.
+ * @param base_field Cached floor field of an accessible exit whose cells are all cells of current_exit.
+ * @param floor_field Integer grid, in floor field units, initialized with the walls and the exit cells of current_exit.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status repair_exit_floor_field(Exit current_exit, const cached_floor_field *base_field, Int_Grid floor_field)
+{
+    int orthogonal = cli_args.diagonal_denominator; // 1.0 in floor field units.
+    int diagonal = cli_args.diagonal_numerator; // cli_args.diagonal in floor field units.
+    int exit_units = EXIT_VALUE * cli_args.diagonal_denominator;
+
+    int floor_field_rule[][3] = 
+                    {{ diagonal,  orthogonal,  diagonal },
+                     {orthogonal,      0,     orthogonal},
+                     { diagonal,  orthogonal,  diagonal }};
+
+    size_t num_cells = (size_t) cli_args.global_line_number * cli_args.global_column_number;
+    Location *queue = malloc(sizeof(Location) * num_cells);
+    bool *is_queued = calloc(num_cells, sizeof(bool));
+    if(queue == NULL || is_queued == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of the queue used to repair a floor field.\n");
+        free(queue);
+        free(is_queued);
+        return FAILURE;
+    }
+
+    for(int i = 0; i < cli_args.global_line_number; i++)
+    {
+        for(int h = 0; h < cli_args.global_column_number; h++)
+        {
+            if(floor_field[i][h] == 0) // Neither wall nor exit of current_exit.
+                floor_field[i][h] = get_field_units(base_field->floor_field, i, h);
+        }
+    }
+
+    // The queue is circular, and holds each cell at most once at a time.
+    size_t queue_start = 0, queue_size = 0;
+    for(int cell_index = 0; cell_index < current_exit->width; cell_index++)
+    {
+        Location exit_cell = current_exit->coordinates[cell_index];
+        size_t position = (size_t) exit_cell.lin * cli_args.global_column_number + exit_cell.col;
+
+        if(! is_queued[position])
+        {
+            is_queued[position] = true;
+            queue[queue_size++] = exit_cell;
+        }
+    }
+
+    while(queue_size > 0)
+    {
+        Location current = queue[queue_start];
+        queue_start = (queue_start + 1) % num_cells;
+        queue_size--;
+        is_queued[(size_t) current.lin * cli_args.global_column_number + current.col] = false;
+
+        int current_cell_value = floor_field[current.lin][current.col];
+
+        for(int j = -1; j < 2; j++)
+        {
+            if(! is_within_grid_lines(current.lin + j))
+                continue;
+
+            for(int k = -1; k < 2; k++)
+            {
+                if(! is_within_grid_columns(current.col + k))
+                    continue;
+
+                Location neighbor = {current.lin + j, current.col + k};
+                int neighbor_value = floor_field[neighbor.lin][neighbor.col];
+
+                if(neighbor_value == WALL_UNITS || neighbor_value == exit_units)
+                    continue;
+
+                if(j != 0 && k != 0)
+                {
+                    if(! is_diagonal_valid(current, (Location){j,k}, floor_field))
+                        continue;
+                }
 
-                if(current_cell_value == WALL_VALUE || current_cell_value == 0.0) // floor field calculations occur only on cells with values
+                int adjacent_cell_value = current_cell_value + floor_field_rule[1 + j][1 + k];
+                if(neighbor_value != 0 && adjacent_cell_value >= neighbor_value)
                     continue;
 
-                for(int j = -1; j < 2; j++)
+                floor_field[neighbor.lin][neighbor.col] = adjacent_cell_value;
+
+                size_t position = (size_t) neighbor.lin * cli_args.global_column_number + neighbor.col;
+                if(! is_queued[position])
+                {
+                    is_queued[position] = true;
+                    queue[(queue_start + queue_size++) % num_cells] = neighbor;
+                }
+            }
+        }
+    }
+
+    free(queue);
+    free(is_queued);
+
+    return SUCCESS;
+}
+
+/**
+ * Determines, for each cell of a band of lines of the region reached by the exit, the neighbors to which the floor field 
+ * propagates: the neighbors inside the grid that are neither walls nor exit cells, and whose diagonal isn't blocked.
+ * 
+ * @param task_data Pointer to the frontier_task_data of the propagation.
+ * @param task_index Index of the band.
+*/
+static void fill_valid_moves_band(void *task_data, int task_index)
+{
+    frontier_task_data *data = task_data;
+    Int_Grid floor_field = data->floor_field;
+    int exit_units = EXIT_VALUE * cli_args.diagonal_denominator;
+
+    int first_line = data->first_cell.lin + task_index * data->band_height;
+    int end_line = first_line + data->band_height;
+    if(end_line > data->last_cell.lin + 1)
+        end_line = data->last_cell.lin + 1;
+
+    for(int i = first_line; i < end_line; i++)
+    {
+        for(int h = data->first_cell.col; h <= data->last_cell.col; h++)
+        {
+            unsigned char moves = 0;
+            int move_index = 0;
+
+            for(int j = -1; j < 2; j++)
+            {
+                for(int k = -1; k < 2; k++)
                 {
-                    if(! is_within_grid_lines(i + j))
+                    if(j == 0 && k == 0)
+                        continue;
+
+                    int move_bit = 1 << move_index++;
+
+                    if(floor_field[i][h] == WALL_UNITS)
+                        continue;
+
+                    if(! is_within_grid_lines(i + j) || ! is_within_grid_columns(h + k))
+                        continue;
+
+                    if(floor_field[i + j][h + k] == WALL_UNITS || floor_field[i + j][h + k] == exit_units)
                         continue;
-                    
-                    for(int k = -1; k < 2; k++)
+
+                    if(j != 0 && k != 0)
                     {
-                        if(! is_within_grid_columns(h + k))
+                        if(! is_diagonal_valid((Location){i,h},(Location){j,k},floor_field))
                             continue;
+                    }
 
-                        if(floor_field[i + j][h + k] == WALL_VALUE || floor_field[i + j][h + k] == EXIT_VALUE)
-                            continue;
+                    moves |= move_bit;
+                }
+            }
+
+            data->valid_moves[(size_t) i * cli_args.global_column_number + h] = moves;
+        }
+    }
+}
+
+/**
+ * Relaxes the neighbors of a chunk of cells of the current layer of the frontier. Each neighbor is lowered with an atomic minimum,
+ * and the neighbors lowered by the task are stored in its region of the updates.
+ * 
+ * @param task_data Pointer to the frontier_task_data of the propagation.
+ * @param task_index Index of the chunk.
+*/
+static void relax_frontier_chunk(void *task_data, int task_index)
+{
+    frontier_task_data *data = task_data;
+    Int_Grid floor_field = data->floor_field;
+    int orthogonal = cli_args.diagonal_denominator; // 1.0 in floor field units.
+    int diagonal = cli_args.diagonal_numerator; // cli_args.diagonal in floor field units.
 
-                        if(j != 0 && k != 0)
-                        {
-                            if(! is_diagonal_valid((Location){i,h},(Location){j,k},floor_field))
-                                continue;
-                        }
-
-                        double adjacent_cell_value = current_cell_value + floor_field_rule[1 + j][1 + k];
-                        if(auxiliary_grid[i + j][h + k] == 0.0)
-                        {    
-                            auxiliary_grid[i + j][h + k] = adjacent_cell_value;
-                            has_changed = true;
-                        }
-                        else if(adjacent_cell_value < auxiliary_grid[i + j][h + k])
-                        {
-                            auxiliary_grid[i + j][h + k] = adjacent_cell_value;
-                            has_changed = true;
-                        }
+    size_t first_cell = (size_t) task_index * data->chunk_size;
+    size_t end_cell = first_cell + data->chunk_size;
+    if(end_cell > data->layer_size)
+        end_cell = data->layer_size;
+
+    frontier_cell *updates = data->updates + first_cell * MAX_NEIGHBORS;
+    size_t num_updates = 0;
+
+    for(size_t layer_index = first_cell; layer_index < end_cell; layer_index++)
+    {
+        frontier_cell current = data->layer[layer_index];
+        if(__atomic_load_n(&floor_field[current.cell.lin][current.cell.col], __ATOMIC_RELAXED) != current.distance)
+            continue; // Lowered after being added to the frontier.
+
+        unsigned char moves = data->valid_moves[(size_t) current.cell.lin * cli_args.global_column_number + current.cell.col];
+        int move_index = 0;
+
+        for(int j = -1; j < 2; j++)
+        {
+            for(int k = -1; k < 2; k++)
+            {
+                if(j == 0 && k == 0)
+                    continue;
+
+                if(! (moves & (1 << move_index++)))
+                    continue;
+
+                int *neighbor_value = &floor_field[current.cell.lin + j][current.cell.col + k];
+                int adjacent_cell_value = current.distance + (j != 0 && k != 0 ? diagonal : orthogonal);
+                int old_value = __atomic_load_n(neighbor_value, __ATOMIC_RELAXED);
+
+                bool is_lowered = false;
+                while(old_value == 0 || adjacent_cell_value < old_value)
+                {
+                    if(__atomic_compare_exchange_n(neighbor_value, &old_value, adjacent_cell_value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                    {
+                        is_lowered = true;
+                        break;
                     }
                 }
+
+                if(is_lowered)
+                    updates[num_updates++] = (frontier_cell){adjacent_cell_value, {current.cell.lin + j, current.cell.col + k}};
             }
         }
-        copy_double_grid(floor_field,auxiliary_grid); 
-        // make sure floor_field now holds t + 1 timestep, allowing auxiliary_grid to hold t + 2 timestep.
     }
-    while(has_changed);
 
-    deallocate_grid((void **) auxiliary_grid, cli_args.global_line_number);
+    data->num_updates[task_index] = num_updates;
+}
+
+/**
+ * Adds a cell to the frontier.
+ * 
+ * @param heap The frontier.
+ * @param new_cell The cell and its distance.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status push_frontier_cell(frontier_heap *heap, frontier_cell new_cell)
+{
+    if(heap->size == heap->capacity)
+    {
+        size_t new_capacity = heap->capacity == 0 ? FRONTIER_CHUNK_SIZE : heap->capacity * 2;
+        frontier_cell *new_cells = realloc(heap->cells, sizeof(frontier_cell) * new_capacity);
+        if(new_cells == NULL)
+        {
+            fprintf(stderr, "Failure in the allocation of the frontier used to propagate a floor field.\n");
+            return FAILURE;
+        }
+
+        heap->cells = new_cells;
+        heap->capacity = new_capacity;
+    }
+
+    size_t position = heap->size++;
+    while(position > 0 && heap->cells[(position - 1) / 2].distance > new_cell.distance)
+    {
+        heap->cells[position] = heap->cells[(position - 1) / 2];
+        position = (position - 1) / 2;
+    }
+    heap->cells[position] = new_cell;
 
     return SUCCESS;
 }
 
+/**
+ * Removes the cell with the smallest distance from the frontier.
+ * 
+ * @param heap The frontier, which must not be empty.
+ * @return The removed cell.
+*/
+static frontier_cell pop_frontier_cell(frontier_heap *heap)
+{
+    frontier_cell smallest = heap->cells[0];
+    frontier_cell last = heap->cells[--heap->size];
+
+    size_t position = 0;
+    while(2 * position + 1 < heap->size)
+    {
+        size_t child = 2 * position + 1;
+        if(child + 1 < heap->size && heap->cells[child + 1].distance < heap->cells[child].distance)
+            child++;
+
+        if(heap->cells[child].distance >= last.distance)
+            break;
+
+        heap->cells[position] = heap->cells[child];
+        position = child;
+    }
+    if(heap->size > 0)
+        heap->cells[position] = last;
+
+    return smallest;
+}
+
 /**
  * Copies the structure (obstacles and walls) from the environment_only_grid to the floor field grid 
  * for the provided exit. Additionally, adds the exit cells to it.
  * 
  * @param current_exit The exit for which the floor field will be initialized.
+ * @param floor_field Integer grid where the floor field of the exit is being calculated, in floor field units.
 */
-static void initialize_exit_floor_field(Exit current_exit)
+static void initialize_exit_floor_field(Exit current_exit, Int_Grid floor_field)
 {
     // Add walls and obstacles to the floor field. 
     for(int i = 0; i < cli_args.global_line_number; i++)
     {
         for(int h = 0; h < cli_args.global_column_number; h++)
         {
-            double cell_value = environment_only_grid[i][h];
+            int cell_value = environment_only_grid[i][h];
             if(cell_value == WALL_VALUE)
-                current_exit->floor_field[i][h] = WALL_VALUE;
+                floor_field[i][h] = WALL_UNITS;
             else
-                current_exit->floor_field[i][h] = 0.0;
+                floor_field[i][h] = 0;
         }
     }
 
@@ -298,46 +1315,23 @@ static void initialize_exit_floor_field(Exit current_exit)
     {
         Location exit_cell = current_exit->coordinates[i];
 
-        current_exit->floor_field[exit_cell.lin][exit_cell.col] = EXIT_VALUE;
+        floor_field[exit_cell.lin][exit_cell.col] = EXIT_VALUE * cli_args.diagonal_denominator;
     }
 }
 
 /**
- * Verify if the given exit is accessible.
- * 
- * @note A exit is accessible if there is, at least, one adjacent empty cell in the vertical or horizontal directions. 
+ * Verifies if the given cell is one of the cells of the exit.
  * 
- * @param current_exit The exit that will be verified.
- * @return bool, where True indicates tha the given exit is accessible, or False otherwise.
+ * @param current_exit The exit.
+ * @param cell Coordinates of the cell.
+ * @return bool, where True indicates that the cell belongs to the exit and False otherwise.
 */
-static bool is_exit_accessible(Exit current_exit)
+static bool is_exit_cell(Exit current_exit, Location cell)
 {
-    if(current_exit == NULL)
-        return false;
-
-    for(int exit_cell_index = 0; exit_cell_index < current_exit->width; exit_cell_index++)
+    for(int cell_index = 0; cell_index < current_exit->width; cell_index++)
     {
-        Location c = current_exit->coordinates[exit_cell_index];
-
-        for(int j = -1; j < 2; j++)
-        {
-            if(! is_within_grid_lines(c.lin + j))
-                continue;
-
-            for(int k = -1; k < 2; k++)
-            {
-                if(! is_within_grid_columns(c.col + k))
-                    continue;
-
-                if(current_exit->floor_field[c.lin + j][c.col + k] == WALL_VALUE || current_exit->floor_field[c.lin + j][c.col + k] == EXIT_VALUE)
-                    continue;
-
-                if(j != 0 && k != 0)
-                    continue; // diagonals
-
-                return true;
-            }
-        }
+        if(current_exit->coordinates[cell_index].lin == cell.lin && current_exit->coordinates[cell_index].col == cell.col)
+            return true;
     }
 
     return false;
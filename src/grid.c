@@ -2,12 +2,16 @@
    File: grid.c
    Author: Daniel Gonçalves
    Date: 2024-05-20
-   Description: This module contains the declaration of grid types for integer and floating-point numbers, as well as functions to allocate, reset, copy, test limits, verify diagonal validity and deallocate those grids.
+   Description: This module contains the declaration of grid types for integer and floating-point numbers, for bitmaps and for floor fields stored with a selectable precision, as well as functions to allocate, reset, copy, test limits, verify diagonal validity and deallocate those grids.
 */
 
 #include<stdio.h>
 #include<stdlib.h>
+#include<string.h>
 #include<stdbool.h>
+#include<math.h>
+#include<inttypes.h>
+#include<sys/mman.h>
 
 #include"../headers/grid.h"
 #include"../headers/cli_processing.h"
@@ -16,6 +20,14 @@
 Int_Grid environment_only_grid = NULL; // Grid containing only the structure and exits.
 Int_Grid pedestrian_position_grid = NULL; // Grid containing pedestrians at their respective positions.
 Int_Grid heatmap_grid = NULL; // Grid containing the count of pedestrian visits per cell.
+Bit_Grid occupancy_bitmap = NULL; // Bitmap mirroring the pedestrian_position_grid, where set bits indicate occupied cells.
+_Thread_local Bit_Grid wall_bitmap = NULL; // Bitmap where set bits indicate the walls and obstacles of the final floor field.
+
+static size_t get_field_cell_size(enum Field_Precision precision);
+static size_t get_field_index(Field_Grid field_grid, int line, int column);
+static uint64_t spread_bits(uint64_t value);
+static void *map_field_cells(size_t *size);
+static uint64_t extract_bit(Bit_Grid bit_grid, int line, int column, bool outside_value);
 
 /**
  * Dynamically allocates an integer matrix of dimensions determined by the function parameters.
@@ -95,6 +107,118 @@ Double_Grid allocate_double_grid(int line_number, int column_number)
     return new_grid;
 }
 
+/**
+ * Dynamically allocates a bitmap of dimensions determined by the function parameters. Each line is stored as an array of
+ * 64-bit words.
+ *
+ * @param line_number Number of lines of the grid.
+ * @param column_number Number of columns of the grid.
+ * @return A NULL pointer, on error, or a Bit_Grid if the grid was successfully allocated.
+ *
+ * @note All bits of the grid are already zeroed.
+ */
+Bit_Grid allocate_bit_grid(int line_number, int column_number)
+{
+    if(line_number <= 0 || column_number <= 0)
+    {
+        fprintf(stderr, "At least one of the grid dimensions was negative or zero.\n");
+        return NULL;
+    }
+
+    int words_per_line = (column_number + BITS_PER_WORD - 1) / BITS_PER_WORD;
+
+    Bit_Grid new_grid = malloc(sizeof(uint64_t *) * line_number);
+    if( new_grid == NULL )
+    {
+        fprintf(stderr, "Failed to allocate memory for the lines of a bit grid.\n");
+        return NULL;
+    }
+
+    for(int i = 0; i < line_number; i++)
+    {
+        new_grid[i] = calloc(words_per_line, sizeof(uint64_t));
+        if(new_grid[i] == NULL)
+        {
+            deallocate_grid((void **) new_grid, i);
+
+            fprintf(stderr, "Failed to allocate memory for the words of the line %d of a bit grid.\n", i);
+            return NULL;
+        }
+    }
+
+    return new_grid;
+}
+
+/**
+ * Dynamically allocates a grid to hold a floor field, where every cell is stored with the given precision and the cells
+ * are ordered in memory according to the given layout.
+ *
+ * @note The fixed-point precisions store each value as an integer number of units of 1 / diagonal_denominator, which
+ * allows all values obtained from sums of 1 and the diagonal value to be stored exactly. Walls and obstacles are stored
+ * as the largest integer of the precision.
+ *
+ * @note The tiled layout stores square tiles of 2^TILE_SIDE_BITS cells side one after the other, while the Morton layout
+ * stores the cells along a Z-order curve. Both keep the neighborhood of a cell in a few cache lines and memory pages, but
+ * require padding the grid up to whole tiles or powers of two. Grids of at least LARGE_PAGE_SIZE bytes are mapped with
+ * large pages when the system provides them.
+ *
+ * @param line_number Number of lines of the grid.
+ * @param column_number Number of columns of the grid.
+ * @param precision How each cell will be stored.
+ * @param layout How the cells will be ordered in memory.
+ * @return A Field_Grid, whose cells pointer is NULL on error.
+ *
+ * @note All positions of the grid are already zeroed.
+ */
+Field_Grid allocate_field_grid(int line_number, int column_number, enum Field_Precision precision, enum Grid_Layout layout)
+{
+    Field_Grid new_grid = {precision, layout, 0, 0, 0, NULL};
+
+    if(line_number <= 0 || column_number <= 0)
+    {
+        fprintf(stderr, "At least one of the grid dimensions was negative or zero.\n");
+        return new_grid;
+    }
+
+    size_t num_cells = (size_t) line_number * column_number;
+    if(layout == LAYOUT_TILED)
+    {
+        int tile_side = 1 << TILE_SIDE_BITS;
+        int tiles_per_column = (line_number + tile_side - 1) / tile_side;
+
+        new_grid.tiles_per_line = (column_number + tile_side - 1) / tile_side;
+        num_cells = (size_t) tiles_per_column * new_grid.tiles_per_line * tile_side * tile_side;
+    }
+    else if(layout == LAYOUT_MORTON)
+    {
+        int line_bits = 0;
+        int column_bits = 0;
+
+        while((1 << line_bits) < line_number)
+            line_bits++;
+        while((1 << column_bits) < column_number)
+            column_bits++;
+
+        // Only the bits present in both coordinates are interleaved. The remaining bits of the largest coordinate are placed above them.
+        new_grid.interleaved_bits = line_bits < column_bits ? line_bits : column_bits;
+        num_cells = (size_t) 1 << (line_bits + column_bits);
+    }
+
+    size_t size = num_cells * get_field_cell_size(precision);
+    if(size >= LARGE_PAGE_SIZE)
+    {
+        new_grid.cells = map_field_cells(&size);
+        new_grid.mapped_size = new_grid.cells != NULL ? size : 0;
+    }
+    else
+        new_grid.cells = calloc(num_cells, get_field_cell_size(precision));
+
+    if(new_grid.cells == NULL)
+        fprintf(stderr, "Failed to allocate memory for the cells of a field grid.\n");
+
+    return new_grid;
+}
+
 /**
  * Reset all positions of an integer grid to zero.
  *
@@ -157,6 +281,70 @@ Function_Status reset_double_grid(Double_Grid double_grid, int line_number, int
     return SUCCESS;
 }
 
+/**
+ * Reset all bits of a bit grid to zero.
+ *
+ * @param bit_grid A bit grid to be reset.
+ * @param line_number Number of lines of the grid.
+ * @param column_number Number of columns of the grid.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+ */
+Function_Status reset_bit_grid(Bit_Grid bit_grid, int line_number, int column_number)
+{
+    if(bit_grid == NULL)
+    {
+        fprintf(stderr, "The Bit_Grid passed to 'reset_bit_grid' was a NULL pointer.\n");
+        return FAILURE;
+    }
+
+    int words_per_line = (column_number + BITS_PER_WORD - 1) / BITS_PER_WORD;
+
+    for(int i = 0; i < line_number; i++)
+    {
+        if(bit_grid[i] == NULL)
+        {
+            fprintf(stderr, "The line %d of the Bit_Grid passed to 'reset_bit_grid' was a NULL pointer.\n", i);
+            return FAILURE;
+        }
+
+        for(int w = 0; w < words_per_line; w++)
+            bit_grid[i][w] = 0;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Copy the content of the source grid to the destination grid.
+ *
+ * @param destination Integer grid where the content is to be copied.
+ * @param source Integer grid to be copied.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+ * 
+ * @note Both grids must be of global size (lines and columns). Otherwise, undefined behavior will happen.
+ */
+Function_Status copy_integer_grid(Int_Grid destination, Int_Grid source)
+{
+    if(destination == NULL || source == NULL)
+    {
+        fprintf(stderr, "The destination or/and source grids received by 'copy_integer_grid' was a null pointer.\n");
+        return FAILURE;
+    }
+
+    for(int i = 0; i < cli_args.global_line_number; i++)
+    {
+        if(destination[i] == NULL || source[i] == NULL)
+        {
+            fprintf(stderr, "The line %d of destination or/and source in 'copy_integer_grid' was a null pointer.\n", i);
+            return FAILURE;
+        }
+
+        memcpy(destination[i], source[i], sizeof(int) * cli_args.global_column_number);
+    }
+
+    return SUCCESS;
+}
+
 /**
  * Copy the content of the source grid to the destination grid.
  *
@@ -191,6 +379,239 @@ Function_Status copy_double_grid(Double_Grid destination, Double_Grid source)
     return SUCCESS;
 }
 
+/**
+ * Stores the content of an integer grid holding floor field units (1 / diagonal_denominator) in a field grid, converting 
+ * every value to the precision of the field grid.
+ *
+ * @note The conversion must be exact, so the equality between floor field values is the same in both grids. A value that
+ * can't be represented with the chosen precision results in failure.
+ *
+ * @param destination Field grid where the content is to be stored.
+ * @param source Integer grid, in floor field units, to be stored.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+ *
+ * @note Both grids must be of global size (lines and columns). Otherwise, undefined behavior will happen.
+ */
+Function_Status store_field_grid(Field_Grid destination, Int_Grid source)
+{
+    return store_field_lines(destination, source, 0, cli_args.global_line_number);
+}
+
+/**
+ * Stores the lines first_line to end_line - 1 of an integer grid holding floor field units in a field grid, as store_field_grid does.
+ *
+ * @note Different lines of the same field grid can be stored by different threads at the same time.
+ *
+ * @param destination Field grid where the content is to be stored.
+ * @param source Integer grid, in floor field units, to be stored.
+ * @param first_line First line to be stored.
+ * @param end_line Line after the last line to be stored.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+ */
+Function_Status store_field_lines(Field_Grid destination, Int_Grid source, int first_line, int end_line)
+{
+    if(destination.cells == NULL || source == NULL)
+    {
+        fprintf(stderr, "The destination or/and source grids received by 'store_field_grid' was a null pointer.\n");
+        return FAILURE;
+    }
+
+    long long int maximum_units = destination.precision == PRECISION_FIXED_16 ? UINT16_MAX : UINT32_MAX;
+
+    for(int i = first_line; i < end_line; i++)
+    {
+        for(int h = 0; h < cli_args.global_column_number; h++)
+        {
+            size_t index = get_field_index(destination, i, h);
+            int units = source[i][h];
+
+            if(units == WALL_UNITS)
+            {
+                // The walls are stored out of band, as values no distance can take.
+                if(destination.precision == PRECISION_DOUBLE)
+                    ((double *) destination.cells)[index] = INFINITY;
+                else if(destination.precision == PRECISION_FLOAT)
+                    ((float *) destination.cells)[index] = INFINITY;
+                else if(destination.precision == PRECISION_FIXED_16)
+                    ((uint16_t *) destination.cells)[index] = UINT16_MAX;
+                else
+                    ((uint32_t *) destination.cells)[index] = UINT32_MAX;
+                continue;
+            }
+
+            double value = (double) units / cli_args.diagonal_denominator;
+
+            if(destination.precision == PRECISION_DOUBLE)
+            {
+                ((double *) destination.cells)[index] = value;
+                continue;
+            }
+
+            if(destination.precision == PRECISION_FLOAT)
+            {
+                float narrow_value = (float) value;
+                if((double) narrow_value != value)
+                {
+                    fprintf(stderr, "The floor field value %lf can't be exactly stored as a float. Use a fixed-point or the double precision.\n", value);
+                    return FAILURE;
+                }
+
+                ((float *) destination.cells)[index] = narrow_value;
+                continue;
+            }
+
+            if(units < 0 || units >= maximum_units)
+            {
+                fprintf(stderr, "The floor field value %lf can't be stored with the chosen fixed-point precision.\n", value);
+                return FAILURE;
+            }
+
+            if(destination.precision == PRECISION_FIXED_16)
+                ((uint16_t *) destination.cells)[index] = (uint16_t) units;
+            else
+                ((uint32_t *) destination.cells)[index] = (uint32_t) units;
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Verifies if a cell of a field grid is a wall or an obstacle.
+ *
+ * @param field_grid A field grid.
+ * @param line Line of the cell.
+ * @param column Column of the cell.
+ * @return bool, where True indicates that the cell is a wall or an obstacle and False otherwise.
+ */
+bool is_field_wall(Field_Grid field_grid, int line, int column)
+{
+    size_t index = get_field_index(field_grid, line, column);
+
+    switch(field_grid.precision)
+    {
+        case PRECISION_FLOAT:
+            return isinf(((float *) field_grid.cells)[index]);
+        case PRECISION_FIXED_16:
+            return ((uint16_t *) field_grid.cells)[index] == UINT16_MAX;
+        case PRECISION_FIXED_32:
+            return ((uint32_t *) field_grid.cells)[index] == UINT32_MAX;
+        default:
+            return isinf(((double *) field_grid.cells)[index]);
+    }
+}
+
+/**
+ * Obtains the value of a cell of a field grid.
+ *
+ * @note The walls are reported as WALL_VALUE, which a distance can also take, so they must be identified with is_field_wall.
+ *
+ * @param field_grid A field grid.
+ * @param line Line of the cell.
+ * @param column Column of the cell.
+ * @return The value of the cell as a double.
+ */
+double get_field_value(Field_Grid field_grid, int line, int column)
+{
+    size_t index = get_field_index(field_grid, line, column);
+
+    switch(field_grid.precision)
+    {
+        case PRECISION_FLOAT:
+        {
+            float value = ((float *) field_grid.cells)[index];
+            return isinf(value) ? WALL_VALUE : value;
+        }
+        case PRECISION_FIXED_16:
+        {
+            uint16_t units_16 = ((uint16_t *) field_grid.cells)[index];
+            return units_16 == UINT16_MAX ? WALL_VALUE : (double) units_16 / cli_args.diagonal_denominator;
+        }
+        case PRECISION_FIXED_32:
+        {
+            uint32_t units_32 = ((uint32_t *) field_grid.cells)[index];
+            return units_32 == UINT32_MAX ? WALL_VALUE : (double) units_32 / cli_args.diagonal_denominator;
+        }
+        default:
+        {
+            double value = ((double *) field_grid.cells)[index];
+            return isinf(value) ? WALL_VALUE : value;
+        }
+    }
+}
+
+/**
+ * Obtains the value of a cell of a field grid in floor field units, i.e., as an integer number of 1 / diagonal_denominator.
+ *
+ * @param field_grid A field grid.
+ * @param line Line of the cell.
+ * @param column Column of the cell.
+ * @return The value of the cell in floor field units, or WALL_UNITS if the cell is a wall or an obstacle.
+ */
+int get_field_units(Field_Grid field_grid, int line, int column)
+{
+    size_t index = get_field_index(field_grid, line, column);
+
+    switch(field_grid.precision)
+    {
+        case PRECISION_FLOAT:
+        {
+            float value = ((float *) field_grid.cells)[index];
+            return isinf(value) ? WALL_UNITS : (int) llround((double) value * cli_args.diagonal_denominator);
+        }
+        case PRECISION_FIXED_16:
+        {
+            uint16_t units_16 = ((uint16_t *) field_grid.cells)[index];
+            return units_16 == UINT16_MAX ? WALL_UNITS : units_16;
+        }
+        case PRECISION_FIXED_32:
+        {
+            uint32_t units_32 = ((uint32_t *) field_grid.cells)[index];
+            return units_32 == UINT32_MAX ? WALL_UNITS : (int) units_32;
+        }
+        default:
+        {
+            double value = ((double *) field_grid.cells)[index];
+            return isinf(value) ? WALL_UNITS : (int) llround(value * cli_args.diagonal_denominator);
+        }
+    }
+}
+
+/**
+ * Verifies if every distance of a floor field of the current environment, in floor field units, is below WALL_UNITS. A path
+ * crosses each cell of the grid at most once, with the largest movement cost, which bounds the distances.
+ *
+ * @return Function_Status: FAILURE (0), if the diagonal fraction and the size of the grid allow distances that don't fit an
+ * integer, or SUCCESS (1).
+ */
+Function_Status verify_field_units_range()
+{
+    int64_t largest_movement = cli_args.diagonal_numerator > cli_args.diagonal_denominator ? cli_args.diagonal_numerator : cli_args.diagonal_denominator;
+    int64_t num_cells = (int64_t) cli_args.global_line_number * cli_args.global_column_number;
+    int64_t largest_distance = (int64_t) EXIT_VALUE * cli_args.diagonal_denominator + num_cells * largest_movement;
+
+    if(largest_distance >= WALL_UNITS)
+    {
+        fprintf(stderr, "The diagonal %d / %d allows floor field values of up to %" PRId64 " units in a %d x %d environment, above the limit of %d. Use a diagonal with fewer decimal places or a smaller environment.\n", 
+                cli_args.diagonal_numerator, cli_args.diagonal_denominator, largest_distance, cli_args.global_line_number, cli_args.global_column_number, WALL_UNITS - 1);
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Calculates the position of a cell along a Morton (Z-order) curve, by interleaving the bits of its coordinates.
+ *
+ * @param line Line of the cell. Must be non-negative.
+ * @param column Column of the cell. Must be non-negative.
+ * @return The Morton code of the cell.
+ */
+uint64_t calculate_morton_code(int line, int column)
+{
+    return (spread_bits(line) << 1) | spread_bits(column);
+}
+
 /**
  * Verifies if a diagonal beginning at origin_cell and ending at origin_cell + coordinate_modifier is valid for crossing 
  * in the given floor field. 
@@ -200,22 +621,22 @@ Function_Status copy_double_grid(Double_Grid destination, Double_Grid source)
  * @param origin_cell Origin cell coordinates. Represents where a pedestrian is or a cell whose neighborhood is being calculated.
  * @param coordinate_modifier Line and column coordinate modifiers. They are added to the origin cell coordinates, and the final 
  * result represents one of the four diagonal cells in the origin cell's neighborhood.
- * @param floor_field A Double_Grid representing a floor field.
+ * @param floor_field An Int_Grid representing a floor field, in floor field units.
  * @return bool, where True indicates that a diagonal is valid and False otherwise.
  */
-bool is_diagonal_valid(Location origin_cell, Location coordinate_modifier, Double_Grid floor_field)
+bool is_diagonal_valid(Location origin_cell, Location coordinate_modifier, Int_Grid floor_field)
 {
     bool is_horizontal_blocked = false; // Indicates if the horizontal cell in the origin_cell's neighborhood, which is adjacent to origin_cell + coordinate_modifier, is blocked.
     bool is_vertical_blocked = false;// Indicates if the vertical cell in the origin_cell's neighborhood, which is adjacent to origin_cell + coordinate_modifier, is blocked.
 
     if(is_within_grid_lines(origin_cell.lin + coordinate_modifier.lin) && 
-    floor_field[origin_cell.lin + coordinate_modifier.lin][origin_cell.col] == WALL_VALUE)
+    floor_field[origin_cell.lin + coordinate_modifier.lin][origin_cell.col] == WALL_UNITS)
     {
         is_vertical_blocked = true;
     }
 
     if(is_within_grid_columns(origin_cell.col + coordinate_modifier.col) && 
-    floor_field[origin_cell.lin][origin_cell.col + coordinate_modifier.col] == WALL_VALUE)
+    floor_field[origin_cell.lin][origin_cell.col + coordinate_modifier.col] == WALL_UNITS)
     {
         is_horizontal_blocked = true;
     }
@@ -229,6 +650,67 @@ bool is_diagonal_valid(Location origin_cell, Location coordinate_modifier, Doubl
     return true;
 }
 
+/**
+ * Sets the bit of the given cell.
+ *
+ * @param bit_grid A bit grid.
+ * @param cell Coordinates of the cell whose bit will be set.
+ */
+void set_grid_bit(Bit_Grid bit_grid, Location cell)
+{
+    bit_grid[cell.lin][cell.col / BITS_PER_WORD] |= (uint64_t) 1 << (cell.col % BITS_PER_WORD);
+}
+
+/**
+ * Verifies if the bit of the given cell is set.
+ *
+ * @param bit_grid A bit grid.
+ * @param cell Coordinates of the cell to be tested.
+ * @return bool, where True indicates that the bit is set and False otherwise.
+ */
+bool is_grid_bit_set(Bit_Grid bit_grid, Location cell)
+{
+    return (bit_grid[cell.lin][cell.col / BITS_PER_WORD] >> (cell.col % BITS_PER_WORD)) & 1;
+}
+
+/**
+ * Extracts the bits of the 3x3 neighborhood centered at the given cell into a 9-bit mask. The bit of the neighbor with
+ * line and column modifiers (j, k), both between -1 and 1, is stored at position (j + 1) * 3 + (k + 1).
+ *
+ * @note Each line of the neighborhood is obtained with at most two word reads.
+ *
+ * @param bit_grid A bit grid.
+ * @param center Coordinates of the center of the neighborhood.
+ * @param outside_value Value assigned to the bits of neighbors that lie outside the grid.
+ * @return An unsigned integer holding the 9-bit mask.
+ */
+unsigned int get_bit_neighborhood(Bit_Grid bit_grid, Location center, bool outside_value)
+{
+    unsigned int neighborhood = 0;
+
+    for(int j = -1; j < 2; j++)
+    {
+        int line = center.lin + j;
+        uint64_t line_bits;
+
+        if(! is_within_grid_lines(line))
+            line_bits = outside_value ? 7 : 0;
+        else if(center.col >= 1 && center.col + 1 < cli_args.global_column_number && (center.col - 1) % BITS_PER_WORD <= BITS_PER_WORD - 3)
+            line_bits = (bit_grid[line][(center.col - 1) / BITS_PER_WORD] >> ((center.col - 1) % BITS_PER_WORD)) & 7;
+            // The three bits are in the same word.
+        else
+        {
+            line_bits = extract_bit(bit_grid, line, center.col - 1, outside_value) | 
+                        extract_bit(bit_grid, line, center.col, outside_value) << 1 | 
+                        extract_bit(bit_grid, line, center.col + 1, outside_value) << 2;
+        }
+
+        neighborhood |= (unsigned int) line_bits << ((j + 1) * 3);
+    }
+
+    return neighborhood;
+}
+
 /**
  * Verifies if the value passed to the function is within the grid lines limits, i. e., 0 <= line_coordinate < cli_args.global_line_number.
  * 
@@ -270,4 +752,139 @@ void deallocate_grid(void **grid, int line_number)
 
         grid = NULL;
     }
-}
\ No newline at end of file
+}
+
+/**
+ * Deallocate all memory assigned to a field grid.
+ *
+ * @param field_grid Pointer to the field grid to be deallocated.
+ */
+void deallocate_field_grid(Field_Grid *field_grid)
+{
+    if(field_grid != NULL)
+    {
+        if(field_grid->mapped_size > 0)
+            munmap(field_grid->cells, field_grid->mapped_size);
+        else
+            free(field_grid->cells);
+
+        field_grid->cells = NULL;
+        field_grid->mapped_size = 0;
+    }
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Determines the size, in bytes, of a cell stored with the given precision.
+ *
+ * @param precision Precision of the cell.
+ * @return The size of the cell.
+ */
+static size_t get_field_cell_size(enum Field_Precision precision)
+{
+    switch(precision)
+    {
+        case PRECISION_FLOAT:
+            return sizeof(float);
+        case PRECISION_FIXED_16:
+            return sizeof(uint16_t);
+        case PRECISION_FIXED_32:
+            return sizeof(uint32_t);
+        default:
+            return sizeof(double);
+    }
+}
+
+/**
+ * Determines the position, in the cell array of a field grid, of the given cell.
+ *
+ * @param field_grid A field grid.
+ * @param line Line of the cell.
+ * @param column Column of the cell.
+ * @return The index of the cell.
+ */
+static size_t get_field_index(Field_Grid field_grid, int line, int column)
+{
+    switch(field_grid.layout)
+    {
+        case LAYOUT_TILED:
+        {
+            int tile_mask = (1 << TILE_SIDE_BITS) - 1;
+            size_t tile_index = (size_t) (line >> TILE_SIDE_BITS) * field_grid.tiles_per_line + (column >> TILE_SIDE_BITS);
+
+            return (tile_index << (2 * TILE_SIDE_BITS)) | ((line & tile_mask) << TILE_SIDE_BITS) | (column & tile_mask);
+        }
+        case LAYOUT_MORTON:
+        {
+            int bits = field_grid.interleaved_bits;
+            uint64_t mask = ((uint64_t) 1 << bits) - 1;
+            uint64_t remaining_bits = (uint64_t) ((line | column) >> bits); // At most one of the coordinates has bits above the interleaved ones.
+
+            return (remaining_bits << (2 * bits)) | calculate_morton_code(line & mask, column & mask);
+        }
+        default:
+            return (size_t) line * cli_args.global_column_number + column;
+    }
+}
+
+/**
+ * Spreads the lower 32 bits of a value, so that a zero bit is placed between every pair of consecutive bits.
+ *
+ * @param value Value to be spread.
+ * @return The spread value.
+ */
+static uint64_t spread_bits(uint64_t value)
+{
+    value &= 0xFFFFFFFF;
+    value = (value | (value << 16)) & 0x0000FFFF0000FFFF;
+    value = (value | (value << 8)) & 0x00FF00FF00FF00FF;
+    value = (value | (value << 4)) & 0x0F0F0F0F0F0F0F0F;
+    value = (value | (value << 2)) & 0x3333333333333333;
+    value = (value | (value << 1)) & 0x5555555555555555;
+
+    return value;
+}
+
+/**
+ * Maps zeroed memory to hold the cells of a field grid, preferably backed by large pages. If the system has no large pages
+ * reserved, normal pages are mapped and the kernel is advised to back them with transparent large pages.
+ *
+ * @param size Pointer to the number of bytes required, which is updated to the size effectively mapped.
+ * @return A pointer to the mapped memory, or NULL on error.
+ */
+static void *map_field_cells(size_t *size)
+{
+    *size = (*size + LARGE_PAGE_SIZE - 1) / LARGE_PAGE_SIZE * LARGE_PAGE_SIZE;
+
+    void *cells = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if(cells != MAP_FAILED)
+        return cells;
+
+    cells = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(cells == MAP_FAILED)
+        return NULL;
+
+    madvise(cells, *size, MADV_HUGEPAGE); // Only a hint, the mapping is still usable if it is refused.
+
+    return cells;
+}
+
+/**
+ * Extracts the bit of a single cell of the bit grid.
+ *
+ * @param bit_grid A bit grid.
+ * @param line Line of the cell. Must be within the grid lines.
+ * @param column Column of the cell.
+ * @param outside_value Value returned if the column is outside the grid.
+ * @return The bit of the cell (0 or 1).
+ */
+static uint64_t extract_bit(Bit_Grid bit_grid, int line, int column, bool outside_value)
+{
+    if(! is_within_grid_columns(column))
+        return outside_value;
+
+    return (bit_grid[line][column / BITS_PER_WORD] >> (column % BITS_PER_WORD)) & 1;
+}
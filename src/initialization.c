@@ -10,20 +10,55 @@
 #include<stdlib.h>
 #include<string.h>
 #include<stdbool.h>
+#include<ctype.h>
 #include<time.h>
+#include<fcntl.h>
+#include<unistd.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
 
 #include"../headers/grid.h"
 #include"../headers/exit.h"
 #include"../headers/pedestrian.h"
 #include"../headers/initialization.h"
 #include"../headers/cli_processing.h"
+#include"../headers/binary_environment.h"
+#include"../headers/pgm_environment.h"
 #include"../headers/shared_resources.h"
 
 const char *environment_path = "environments/";
 const char *auxiliary_path = "auxiliary/";
 const char *output_path = "output/";
 
-static Function_Status open_environment_file(FILE **environment_file);
+bool environment_file_is_binary = false; // Whether the environment was loaded from a file in the binary format.
+
+enum Symbol_Class {
+    SYMBOL_UNKNOWN = 0, 
+    SYMBOL_EMPTY, 
+    SYMBOL_WALL, 
+    SYMBOL_EXIT, 
+    SYMBOL_PEDESTRIAN
+};
+
+// Class of each symbol that can be found in an environment file. Symbols not listed are unknown.
+static const unsigned char symbol_table[256] = {
+    ['.'] = SYMBOL_EMPTY,
+    ['#'] = SYMBOL_WALL,
+    ['_'] = SYMBOL_EXIT,
+    ['p'] = SYMBOL_PEDESTRIAN,
+    ['P'] = SYMBOL_PEDESTRIAN
+};
+
+typedef struct{
+    const char *content;
+    size_t size;
+    size_t position; // Position of the next character to be parsed.
+}mapped_file;
+
+static Function_Status map_environment_file(mapped_file *environment_file);
+static Function_Status extract_environment_dimensions(mapped_file *environment_file);
+static bool extract_integer(mapped_file *environment_file, int *value);
+static Function_Status process_environment_line(mapped_file *environment_file, int line);
 static Function_Status symbol_processing(char read_char, Location coordinates);
 
 /**
@@ -103,7 +138,7 @@ Function_Status open_output_file(FILE **output_file)
 }
 
 /**
- * Allocates the integer grids necessary for the program (environment, pedestrian and heatmap grids).
+ * Allocates the integer grids (environment, pedestrian and heatmap grids) and the bitmaps (occupancy and wall bitmaps) necessary for the program.
  *  
  * @return Function_Status: FAILURE (0) or SUCCESS (1).
 */
@@ -118,67 +153,68 @@ Function_Status allocate_grids()
         return FAILURE;
     }
 
+    occupancy_bitmap = allocate_bit_grid(cli_args.global_line_number, cli_args.global_column_number);
+    wall_bitmap = allocate_bit_grid(cli_args.global_line_number, cli_args.global_column_number);
+    if(occupancy_bitmap == NULL || wall_bitmap == NULL)
+    {
+        fprintf(stderr,"Failure during allocation of the bitmaps with dimensions: %d x %d.\n", cli_args.global_line_number, cli_args.global_column_number);
+        return FAILURE;
+    }
+
     return SUCCESS;
 }
 
 /**
  * Loads the environment stored in the file provided by the --env-file option.
  * 
+ * @note The file is memory-mapped. PGM images are loaded when the PGM_IMAGE origin is selected. Files in the binary format are recognized by their magic bytes. Otherwise, the text
+ * format is assumed and each line is parsed in bulk, with the symbols classified through a lookup table.
+ * 
  * @return Function_Status: FAILURE (0) or SUCCESS (1).
 */
 Function_Status load_environment()
 {
-    FILE *environment_file = NULL;
+    mapped_file environment_file;
 
-    if(open_environment_file(&environment_file) == FAILURE)
+    if(map_environment_file(&environment_file) == FAILURE)
         return FAILURE;
 
-    if( fscanf(environment_file,"%d %d", &(cli_args.global_line_number), &(cli_args.global_column_number)) != 2)
+    if(cli_args.environment_origin == PGM_IMAGE)
     {
-        fprintf(stderr, "Environment dimensions weren't found in the first line of the file.\n");
-        return FAILURE;
+        Function_Status returned_status = load_pgm_environment(environment_file.content, environment_file.size);
+        if(environment_file.size > 0)
+            munmap((void *) environment_file.content, environment_file.size);
+
+        return returned_status;
     }
 
-    if(allocate_grids() == FAILURE)
-        return FAILURE;
+    environment_file_is_binary = is_binary_environment(environment_file.content, environment_file.size);
+    if(environment_file_is_binary)
+    {
+        Function_Status returned_status = load_binary_environment(environment_file.content, environment_file.size);
+        munmap((void *) environment_file.content, environment_file.size);
 
-    if(reset_integer_grid(pedestrian_position_grid, cli_args.global_line_number, cli_args.global_column_number) == FAILURE)
-        return FAILURE;
+        return returned_status;
+    }
 
-    char read_char = '\0';
-    fscanf(environment_file,"%c",&read_char);// responsible for eliminating the '\n' after the environment dimensions.
-    for(int i = 0; i < cli_args.global_line_number; i++)
-    {
-        int h = 0;
-        for(; h <= cli_args.global_column_number; h++)
-        {
-            if(fscanf(environment_file,"%c",&read_char) == EOF)
-                break;
+    Function_Status returned_status = extract_environment_dimensions(&environment_file);
 
-            if(h == cli_args.global_column_number && read_char != '\n')
-            {
-                // The end of a line should have been reached
-                fprintf(stderr,"Line %d has more columns than the extracted column number.\n", i);
-                return FAILURE;
-            }
+    if(returned_status == SUCCESS)
+        returned_status = allocate_grids();
 
-            if(read_char == '\n')
-                break;
+    if(returned_status == SUCCESS)
+        returned_status = reset_integer_grid(pedestrian_position_grid, cli_args.global_line_number, cli_args.global_column_number);
 
-            if( symbol_processing(read_char,(Location){i,h}) == FAILURE)
-                return FAILURE;
-        }
+    if(returned_status == SUCCESS)
+        returned_status = reset_bit_grid(occupancy_bitmap, cli_args.global_line_number, cli_args.global_column_number);
 
-        if( h < cli_args.global_column_number)
-        {
-            fprintf(stderr,"Line %d has less columns than the extracted column number.\n", i);
-            return FAILURE;
-        }
-    }
+    for(int i = 0; i < cli_args.global_line_number && returned_status == SUCCESS; i++)
+        returned_status = process_environment_line(&environment_file, i);
 
-    fclose(environment_file);
+    if(environment_file.size > 0)
+        munmap((void *) environment_file.content, environment_file.size);
 
-    return SUCCESS;
+    return returned_status;
 }
 
 /**
@@ -205,135 +241,171 @@ Function_Status generate_environment()
     return SUCCESS;
 }
 
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
 /**
- * Determines the number of simulation sets (number of non-empty lines) present in the auxiliary file.
+ * Maps the environment file into memory in read mode.
  * 
- * @param auxiliary_file File where the simulation sets are stored.
- * @return A non-negative integer, indicating the number of simulation sets, or -1, in failure.
+ * @param environment_file Pointer to the mapped_file structure that will hold the mapped content.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
 */
-int extract_simulation_set_quantity(FILE *auxiliary_file)
+static Function_Status map_environment_file(mapped_file *environment_file)
 {
-    if(auxiliary_file == NULL)
-        return -1;
+    char complete_path[300] = "";
+    sprintf(complete_path,"%s%s",environment_path,cli_args.environment_filename);
 
-    char current_char = '\n', previous_char = '\n';
-    int count = 0; 
+    *environment_file = (mapped_file) {NULL, 0, 0};
 
-    while(1)
+    int file_descriptor = open(complete_path, O_RDONLY);
+    if(file_descriptor == -1)
     {
-        previous_char = current_char;
-        current_char = fgetc(auxiliary_file);
-
-        if(current_char == '\n')
-        {
-            if(previous_char == '\n')
-                continue; // ignore empty lines
+        fprintf(stderr,"It was not possible to open the environment file: %s.\n",cli_args.environment_filename);
+        return FAILURE;
+    }
 
-            count++;
-        }
+    struct stat file_status;
+    if(fstat(file_descriptor, &file_status) == -1)
+    {
+        fprintf(stderr,"It was not possible to determine the size of the environment file: %s.\n",cli_args.environment_filename);
+        close(file_descriptor);
+        return FAILURE;
+    }
 
-        if(current_char == EOF)
+    if(file_status.st_size > 0) // Empty files can't be mapped, but are reported when the dimensions aren't found.
+    {
+        void *content = mmap(NULL, file_status.st_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        if(content == MAP_FAILED)
         {
-            if(previous_char != '\n')
-                count++; //Count the last line that hasn't ended with a newline
+            fprintf(stderr,"It was not possible to map the environment file: %s.\n",cli_args.environment_filename);
+            close(file_descriptor);
+            return FAILURE;
+        }
 
-            if(feof(auxiliary_file))
-                break;
+        madvise(content, file_status.st_size, MADV_SEQUENTIAL);
 
-            if(ferror(auxiliary_file))
-            {
-                fprintf(stderr, "Error while reading the auxiliary file.");
-                return -1;
-            }
-        }
+        environment_file->content = content;
+        environment_file->size = file_status.st_size;
     }
 
-    fseek(auxiliary_file, 0, SEEK_SET);
+    close(file_descriptor); // The mapping remains valid after the file is closed.
 
-    return count;
+    return SUCCESS;
 }
 
 /**
- * Read the next line of the provided auxiliary file and extract the exits coordinates from it, adding them to the environment.
- * 
- * @param auxiliary_file File where the simulation sets are stored.
- * @param exit_number Pointer to a integer, where will be stored the number of exits in the simulation set.
+ * Extracts the environment dimensions from the first line of the mapped environment file and skips the character that follows them.
  * 
+ * @param environment_file The mapped environment file, positioned at its beginning.
  * @return Function_Status: FAILURE (0) or SUCCESS (1).
 */
-Function_Status get_next_simulation_set(FILE *auxiliary_file, int *exit_number)
+static Function_Status extract_environment_dimensions(mapped_file *environment_file)
 {
-    Location temp_coordinates;
-    int exit_count = 0; // Number of extracted exits.
-    char read_char = '\0';
-   
-    bool new_exit = true; // True for a new exit, False for an expansion over the last new exit.
-
-    while(1)
+    if( ! extract_integer(environment_file, &(cli_args.global_line_number)) || 
+        ! extract_integer(environment_file, &(cli_args.global_column_number)))
     {
-        int returned_value = fscanf(auxiliary_file,"%d %d %c ",&temp_coordinates.lin,&temp_coordinates.col,&read_char);
+        fprintf(stderr, "Environment dimensions weren't found in the first line of the file.\n");
+        return FAILURE;
+    }
 
-        if( returned_value == EOF)
-            break; // All simulation sets were processed.
+    if(environment_file->position < environment_file->size)
+        environment_file->position++; // responsible for eliminating the '\n' after the environment dimensions.
 
-        if( returned_value != 3)
-        {
-            fprintf(stderr, "Failure while reading the auxiliary file for exit coordinates. Verify if the syntax is being correctly followed.\n");
-            return FAILURE;
-        }
+    return SUCCESS;
+}
 
-        if(new_exit == true)
-        {
-            exit_count++;
-            if( add_new_exit(temp_coordinates) == FAILURE)
-                return FAILURE;
-        }
-        else
-        {
-            if( expand_exit(exits_set.list[exits_set.num_exits - 1],temp_coordinates) == FAILURE)
-                return FAILURE;
-        }
+/**
+ * Extracts a decimal integer from the current position of the mapped environment file, skipping any preceding whitespace.
+ * 
+ * @param environment_file The mapped environment file.
+ * @param value Pointer to the integer where the extracted value will be stored.
+ * @return bool, where True indicates that an integer was extracted and False otherwise.
+*/
+static bool extract_integer(mapped_file *environment_file, int *value)
+{
+    const char *content = environment_file->content;
+    size_t position = environment_file->position;
 
-        if(read_char == '+')
-            new_exit = false;
-        else if(read_char == ',')
-            new_exit = true;
-        else if(read_char == '.')
-            break;
-        else
-        {
-            fprintf(stderr, "Unknow symbol in the auxiliary file.\n");
-            return FAILURE;
-        }
+    while(position < environment_file->size && isspace((unsigned char) content[position]))
+        position++;
+
+    int sign = 1;
+    if(position < environment_file->size && (content[position] == '-' || content[position] == '+'))
+    {
+        sign = content[position] == '-' ? -1 : 1;
+        position++;
+    }
+
+    size_t first_digit = position;
+    long long int extracted_value = 0;
+    while(position < environment_file->size && isdigit((unsigned char) content[position]))
+    {
+        if(extracted_value <= __INT_MAX__)
+            extracted_value = extracted_value * 10 + (content[position] - '0');
+        position++;
     }
 
-    *exit_number = exit_count;
+    if(position == first_digit || extracted_value > __INT_MAX__)
+        return false;
 
-    return SUCCESS;
-}
+    *value = (int) (sign * extracted_value);
+    environment_file->position = position;
 
-/* ---------------- ---------------- ---------------- ---------------- ---------------- */
-/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
-/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+    return true;
+}
 
 /**
- * Opens the environment file in read mode.
+ * Processes the next line of the mapped environment file, which must contain exactly global_column_number symbols.
  * 
- * @param environment_file Pointer to the FILE structure that will hold the file descriptor.
+ * @note Walls and empty cells are written directly in the environment_only_grid. Only exits and pedestrians, which
+ * may create new structures, are dispatched to symbol_processing.
+ * 
+ * @param environment_file The mapped environment file, positioned at the beginning of the line.
+ * @param line Index of the line in the environment grid.
  * @return Function_Status: FAILURE (0) or SUCCESS (1).
 */
-static Function_Status open_environment_file(FILE **environment_file)
+static Function_Status process_environment_line(mapped_file *environment_file, int line)
 {
-    char complete_path[300] = "";
-    sprintf(complete_path,"%s%s",environment_path,cli_args.environment_filename);
+    const char *line_start = environment_file->content + environment_file->position;
+    size_t remaining_size = environment_file->size - environment_file->position;
 
-    *environment_file = fopen(complete_path, "r");
-    if(*environment_file == NULL)
+    const char *line_end = memchr(line_start, '\n', remaining_size);
+    size_t line_length = line_end != NULL ? (size_t) (line_end - line_start) : remaining_size;
+    int symbols_to_process = line_length < (size_t) cli_args.global_column_number ? (int) line_length : cli_args.global_column_number;
+
+    int *grid_line = environment_only_grid[line];
+    for(int h = 0; h < symbols_to_process; h++)
     {
-        fprintf(stderr,"It was not possible to open the environment file: %s.\n",cli_args.environment_filename);
+        switch(symbol_table[(unsigned char) line_start[h]])
+        {
+            case SYMBOL_EMPTY:
+                grid_line[h] = 0;
+                break;
+            case SYMBOL_WALL:
+                grid_line[h] = WALL_VALUE;
+                break;
+            default:
+                if( symbol_processing(line_start[h], (Location){line, h}) == FAILURE)
+                    return FAILURE;
+        }
+    }
+
+    if(line_length > (size_t) cli_args.global_column_number)
+    {
+        // The end of a line should have been reached
+        fprintf(stderr,"Line %d has more columns than the extracted column number.\n", line);
         return FAILURE;
     }
 
+    if(line_length < (size_t) cli_args.global_column_number)
+    {
+        fprintf(stderr,"Line %d has less columns than the extracted column number.\n", line);
+        return FAILURE;
+    }
+
+    environment_file->position += line_end != NULL ? line_length + 1 : line_length;
+
     return SUCCESS;
 }
 
@@ -375,11 +447,10 @@ static Function_Status symbol_processing(char read_char, Location coordinates)
                     return FAILURE;
 
                 pedestrian_position_grid[coordinates.lin][coordinates.col] = pedestrian_set.list[pedestrian_set.num_pedestrians - 1]->id;
+                set_grid_bit(occupancy_bitmap, coordinates);
             }
           	environment_only_grid[coordinates.lin][coordinates.col] = 0;
 
-            break;
-        case '\n':
             break;
         default:
             fprintf(stderr,"Unknow symbol in the environment file: %c.\n", read_char);
@@ -0,0 +1,325 @@
+/*
+   File: memoization.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-19
+   Description: This module implements the memoization of the simulation sets. The exits of each simulation set are put in a
+                canonical form, with the cells of each exit and the exits sorted, so that simulation sets that only differ in the
+                order of their exits or cells are identified as the same one. The output of each distinct simulation set is kept,
+                indexed by the hash of its canonical form, and replayed for the repeated ones.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<stdint.h>
+
+#include"../headers/exit.h"
+#include"../headers/memoization.h"
+#include"../headers/shared_resources.h"
+
+#define INITIAL_NUM_BUCKETS 1024
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+struct memoized_set{
+    uint64_t hash;
+    int *canonical_form; // Number of exits, followed by the width and the sorted cells of each exit, in the order of the sorted exits.
+    size_t canonical_size;
+    char *output; // Output written for the simulation set, replayed for the repeated ones.
+    size_t output_size;
+    Function_Status status; // As returned by calculate_final_floor_field.
+    Memoized_Set next; // Next memoized set in the same bucket.
+};
+
+typedef struct{
+    Memoized_Set *buckets;
+    int num_buckets;
+    int num_sets;
+    int *pending_form; // Canonical form of the last simulation set searched, stored if it is memoized.
+    size_t pending_size;
+    uint64_t pending_hash;
+}memoization_table;
+
+static memoization_table memoized_sets = {NULL, 0, 0, NULL, 0, 0};
+
+static Function_Status build_canonical_form();
+static Function_Status grow_memoization_table();
+static uint64_t hash_canonical_form(int *canonical_form, size_t canonical_size);
+static int compare_cells(const void *first, const void *second);
+static int compare_exits(const void *first, const void *second);
+
+/**
+ * Searches the memoized simulation sets for the active simulation set (exits_set), in its canonical form.
+ *
+ * @note The canonical form is kept until the next search, to be stored by memoize_simulation_set.
+ *
+ * @param memoized_set Pointer to the Memoized_Set where the memoized simulation set will be stored, or NULL if it wasn't memoized yet.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status find_memoized_simulation_set(Memoized_Set *memoized_set)
+{
+    *memoized_set = NULL;
+
+    if(build_canonical_form() == FAILURE)
+        return FAILURE;
+
+    if(memoized_sets.num_buckets == 0)
+        return SUCCESS;
+
+    Memoized_Set current = memoized_sets.buckets[memoized_sets.pending_hash % memoized_sets.num_buckets];
+    for(; current != NULL; current = current->next)
+    {
+        if(current->hash == memoized_sets.pending_hash && current->canonical_size == memoized_sets.pending_size &&
+           memcmp(current->canonical_form, memoized_sets.pending_form, sizeof(int) * memoized_sets.pending_size) == 0)
+        {
+            *memoized_set = current;
+            break;
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Memoizes the simulation set last searched with find_memoized_simulation_set, which wasn't found.
+ *
+ * @param output Output written for the simulation set, allocated with malloc. Owned by the memoized simulation set.
+ * @param output_size Size, in bytes, of the output.
+ * @param status Status returned by calculate_final_floor_field for the simulation set.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status memoize_simulation_set(char *output, size_t output_size, Function_Status status)
+{
+    if(memoized_sets.num_sets >= memoized_sets.num_buckets && grow_memoization_table() == FAILURE)
+    {
+        free(output);
+        return FAILURE;
+    }
+
+    Memoized_Set new_set = malloc(sizeof(struct memoized_set));
+    if(new_set == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of a memoized simulation set.\n");
+        free(output);
+        return FAILURE;
+    }
+
+    *new_set = (struct memoized_set) {memoized_sets.pending_hash, memoized_sets.pending_form, memoized_sets.pending_size, output, output_size, status, NULL};
+    memoized_sets.pending_form = NULL; // Owned by the memoized simulation set.
+    memoized_sets.pending_size = 0;
+
+    Memoized_Set *bucket = &memoized_sets.buckets[new_set->hash % memoized_sets.num_buckets];
+    new_set->next = *bucket;
+    *bucket = new_set;
+    memoized_sets.num_sets++;
+
+    return SUCCESS;
+}
+
+/**
+ * Writes the output of a memoized simulation set.
+ *
+ * @param memoized_set The memoized simulation set.
+ * @param output_file Stream where the output will be written.
+ * @return Function_Status: FAILURE (0), SUCCESS (1), INACCESSIBLE_EXIT (2) or UNREACHABLE_PEDESTRIANS (3), as returned by
+ * calculate_final_floor_field for the memoized simulation set.
+*/
+Function_Status replay_memoized_simulation_set(Memoized_Set memoized_set, FILE *output_file)
+{
+    if(fwrite(memoized_set->output, 1, memoized_set->output_size, output_file) != memoized_set->output_size)
+    {
+        fprintf(stderr, "Failure in the writing of the output of a memoized simulation set.\n");
+        return FAILURE;
+    }
+
+    return memoized_set->status;
+}
+
+/**
+ * Deallocates every memoized simulation set.
+*/
+void deallocate_memoized_simulation_sets()
+{
+    for(int bucket_index = 0; bucket_index < memoized_sets.num_buckets; bucket_index++)
+    {
+        Memoized_Set current = memoized_sets.buckets[bucket_index];
+        while(current != NULL)
+        {
+            Memoized_Set next = current->next;
+            free(current->canonical_form);
+            free(current->output);
+            free(current);
+            current = next;
+        }
+    }
+
+    free(memoized_sets.buckets);
+    free(memoized_sets.pending_form);
+    memoized_sets = (memoization_table) {NULL, 0, 0, NULL, 0, 0};
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Builds the canonical form of the active simulation set and its hash, as the pending form of the memoization table.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status build_canonical_form()
+{
+    size_t canonical_size = 1;
+    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+        canonical_size += 1 + 2 * (size_t) exits_set.list[exit_index]->width;
+
+    int *canonical_form = malloc(sizeof(int) * canonical_size);
+    int **exit_forms = malloc(sizeof(int *) * (exits_set.num_exits > 0 ? exits_set.num_exits : 1));
+    if(canonical_form == NULL || exit_forms == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of the canonical form of a simulation set.\n");
+        free(canonical_form);
+        free(exit_forms);
+        return FAILURE;
+    }
+
+    // Each exit is written as its width followed by its sorted cells, so the exits can then be sorted as a whole.
+    int *exit_form = canonical_form + 1;
+    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+    {
+        Exit current_exit = exits_set.list[exit_index];
+
+        exit_form[0] = current_exit->width;
+        memcpy(exit_form + 1, current_exit->coordinates, sizeof(Location) * current_exit->width);
+        qsort(exit_form + 1, current_exit->width, sizeof(Location), compare_cells);
+
+        exit_forms[exit_index] = exit_form;
+        exit_form += 1 + 2 * current_exit->width;
+    }
+
+    qsort(exit_forms, exits_set.num_exits, sizeof(int *), compare_exits);
+
+    free(memoized_sets.pending_form);
+    memoized_sets.pending_form = malloc(sizeof(int) * canonical_size);
+    if(memoized_sets.pending_form == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of the canonical form of a simulation set.\n");
+        free(canonical_form);
+        free(exit_forms);
+        return FAILURE;
+    }
+
+    int *pending_form = memoized_sets.pending_form;
+    *pending_form++ = exits_set.num_exits;
+    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+    {
+        size_t exit_size = 1 + 2 * (size_t) exit_forms[exit_index][0];
+        memcpy(pending_form, exit_forms[exit_index], sizeof(int) * exit_size);
+        pending_form += exit_size;
+    }
+
+    memoized_sets.pending_size = canonical_size;
+    memoized_sets.pending_hash = hash_canonical_form(memoized_sets.pending_form, canonical_size);
+
+    free(canonical_form);
+    free(exit_forms);
+
+    return SUCCESS;
+}
+
+/**
+ * Doubles the number of buckets of the memoization table, redistributing the memoized simulation sets.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status grow_memoization_table()
+{
+    int num_buckets = memoized_sets.num_buckets == 0 ? INITIAL_NUM_BUCKETS : memoized_sets.num_buckets * 2;
+
+    Memoized_Set *buckets = calloc(num_buckets, sizeof(Memoized_Set));
+    if(buckets == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of the memoization table of the simulation sets.\n");
+        return FAILURE;
+    }
+
+    for(int bucket_index = 0; bucket_index < memoized_sets.num_buckets; bucket_index++)
+    {
+        Memoized_Set current = memoized_sets.buckets[bucket_index];
+        while(current != NULL)
+        {
+            Memoized_Set next = current->next;
+            current->next = buckets[current->hash % num_buckets];
+            buckets[current->hash % num_buckets] = current;
+            current = next;
+        }
+    }
+
+    free(memoized_sets.buckets);
+    memoized_sets.buckets = buckets;
+    memoized_sets.num_buckets = num_buckets;
+
+    return SUCCESS;
+}
+
+/**
+ * Calculates the 64-bit FNV-1a hash of a canonical form.
+ *
+ * @param canonical_form The canonical form.
+ * @param canonical_size Number of integers of the canonical form.
+ * @return The hash.
+*/
+static uint64_t hash_canonical_form(int *canonical_form, size_t canonical_size)
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    const unsigned char *bytes = (const unsigned char *) canonical_form;
+
+    for(size_t byte_index = 0; byte_index < sizeof(int) * canonical_size; byte_index++)
+    {
+        hash ^= bytes[byte_index];
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/**
+ * Compares two cells by line and then by column.
+ *
+ * @param first Pointer to the first Location.
+ * @param second Pointer to the second Location.
+ * @return A negative integer, 0 or a positive integer if the first cell comes before, is equal to or comes after the second one.
+*/
+static int compare_cells(const void *first, const void *second)
+{
+    const Location *first_cell = first;
+    const Location *second_cell = second;
+
+    if(first_cell->lin != second_cell->lin)
+        return first_cell->lin < second_cell->lin ? -1 : 1;
+
+    return (first_cell->col > second_cell->col) - (first_cell->col < second_cell->col);
+}
+
+/**
+ * Compares two exits, written as their width followed by their sorted cells, by their cells and then by their width.
+ *
+ * @param first Pointer to the pointer to the first exit.
+ * @param second Pointer to the pointer to the second exit.
+ * @return A negative integer, 0 or a positive integer if the first exit comes before, is equal to or comes after the second one.
+*/
+static int compare_exits(const void *first, const void *second)
+{
+    const int *first_exit = *(int * const *) first;
+    const int *second_exit = *(int * const *) second;
+    int common_width = first_exit[0] < second_exit[0] ? first_exit[0] : second_exit[0];
+
+    for(int cell_index = 0; cell_index < common_width; cell_index++)
+    {
+        int comparison = compare_cells(first_exit + 1 + 2 * cell_index, second_exit + 1 + 2 * cell_index);
+        if(comparison != 0)
+            return comparison;
+    }
+
+    return (first_exit[0] > second_exit[0]) - (first_exit[0] < second_exit[0]);
+}
@@ -7,6 +7,7 @@
 
 #include<stdio.h>
 #include<stdlib.h>
+#include<string.h>
 #include<stdbool.h>
 #include<math.h>
 
@@ -24,13 +25,18 @@ typedef struct reduced_line_equation{
     double linear_coefficient; // Where the line intersects the y-axis.
 }reduced_line_equation;
 
+typedef struct spatial_key{
+    uint64_t code; // Position of the pedestrian along the Morton curve.
+    Pedestrian pedestrian;
+}spatial_key;
+
 typedef struct cell_conflict{
     int num_pedestrians;
     int pedestrian_ids[8];
     int pedestrian_allowed;
 }cell_conflict;
 
-Pedestrian_Set pedestrian_set = {NULL,0};
+Pedestrian_Set pedestrian_set = {NULL, NULL, 0, 0};
 
 static Pedestrian create_pedestrian(Location ped_coordinates);
 static bool are_pedestrian_paths_crossing(Pedestrian first_pedestrian, Pedestrian second_pedestrian);
@@ -38,6 +44,10 @@ static Function_Status calculate_reduced_line_equation(Location origin, Location
 static void calculate_intersection_point(reduced_line_equation first_line, reduced_line_equation second_line, double *x, double *y);
 static bool is_intersection_within_pedestrian_movement(double x_coordinate, double y_coordinate, Pedestrian pedestrian);
 static void solve_X_movement(Pedestrian first_pedestrian, Pedestrian second_pedestrian);
+static void add_pedestrian_to_conflict(Cell_Conflict conflict, int pedestrian_id);
+static int draw_movement_random_number(Pedestrian pedestrian);
+static int compare_spatial_keys(const void *first, const void *second);
+static int compare_cell_conflicts(const void *first, const void *second);
 
 /**
  * Inserts a specified number of pedestrians at random locations within the environment.
@@ -58,6 +68,9 @@ Function_Status insert_pedestrians_at_random(int num_pedestrians_to_insert)
     if(reset_integer_grid(pedestrian_position_grid, cli_args.global_line_number, cli_args.global_column_number) == FAILURE)
         return FAILURE;
 
+    if(reset_bit_grid(occupancy_bitmap, cli_args.global_line_number, cli_args.global_column_number) == FAILURE)
+        return FAILURE;
+
     for(int p_index = 0; p_index < num_pedestrians_to_insert;)
     {
         int line = rand() % (cli_args.global_line_number - 1) + 1;
@@ -71,14 +84,15 @@ Function_Status insert_pedestrians_at_random(int num_pedestrians_to_insert)
                 continue;
         }
 
-        if(pedestrian_position_grid[line][column] != 0 || exits_set.final_floor_field[line][column] == EXIT_VALUE 
-            || exits_set.final_floor_field[line][column] == WALL_VALUE)
+        if(pedestrian_position_grid[line][column] != 0 || get_field_value(exits_set.final_floor_field, line, column) == EXIT_VALUE || 
+           is_field_wall(exits_set.final_floor_field, line, column))
             continue;
 
         if( add_new_pedestrian(random_coordinates) == FAILURE)
             return FAILURE;
 
         pedestrian_position_grid[line][column] = pedestrian_set.list[pedestrian_set.num_pedestrians - 1]->id;
+        set_grid_bit(occupancy_bitmap, random_coordinates);
 
         p_index++;
     }
@@ -111,15 +125,23 @@ Function_Status add_new_pedestrian(Location ped_coordinates)
         return FAILURE;
     }
 
+    pedestrian_set.by_id = realloc(pedestrian_set.by_id, sizeof(Pedestrian) * pedestrian_set.num_pedestrians);
+    if(pedestrian_set.by_id == NULL)
+    {
+        fprintf(stderr,"Failure in the realloc of the pedestrian_set ID index.\n");
+        return FAILURE;
+    }
+
     new_pedestrian->id = pedestrian_set.num_pedestrians;
     pedestrian_set.list[pedestrian_set.num_pedestrians - 1] = new_pedestrian;
+    pedestrian_set.by_id[pedestrian_set.num_pedestrians - 1] = new_pedestrian;
 
     return SUCCESS;
 }
 
 
 /**
- * Deallocate the pedestrian_set list and reset the number of pedestrians.
+ * Deallocate the pedestrian_set list and ID index and reset the number of pedestrians.
 */
 void deallocate_pedestrians()
 {
@@ -128,14 +150,19 @@ void deallocate_pedestrians()
         
     free(pedestrian_set.list);
     pedestrian_set.list = NULL;
+    free(pedestrian_set.by_id);
+    pedestrian_set.by_id = NULL;
 
     pedestrian_set.num_pedestrians = 0;
+    pedestrian_set.num_stalled_timesteps = 0;
 }
 
 /**
  * For each pedestrian, determines if they will enter a panic state with a probability defined by PANIC_PROBABILITY.
  * If a pedestrian enters panic, they will remain in the same position during the current timestep.
  * 
+ * @note The pedestrians are visited in the ID order, so the random numbers don't depend on the spatial sorting.
+ * 
  * @return A integer, indicating the number of pedestrians in panic.
 */
 int determine_pedestrians_in_panic()
@@ -143,16 +170,16 @@ int determine_pedestrians_in_panic()
     int num_pedestrians_in_panic = 0;
     for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
     {
-        if(pedestrian_set.list[p_index]->state == GOT_OUT)
+        if(pedestrian_set.by_id[p_index]->state == GOT_OUT)
             continue;
 
         if((rand() % 100 + 1) / 100.0 <= PANIC_PROBABILITY)
         {
-            pedestrian_set.list[p_index]->in_panic = true;
+            pedestrian_set.by_id[p_index]->in_panic = true;
             num_pedestrians_in_panic++;
 
             if(cli_args.show_debug_information)
-                printf("%d in panic.\n", pedestrian_set.list[p_index]->id);
+                printf("%d in panic.\n", pedestrian_set.by_id[p_index]->id);
         }
     }
 
@@ -161,9 +188,20 @@ int determine_pedestrians_in_panic()
 
 /**
  * Determines the destination cell for each pedestrian.
+ * 
+ * @note When the pedestrian list is spatially sorted, the random numbers are drawn beforehand in the ID order, as they are drawn 
+ * without the sorting, so the results are the same.
 */
 void evaluate_pedestrians_movements()
 {
+    bool is_list_sorted = cli_args.spatial_sort_interval > 0;
+
+    if(is_list_sorted)
+    {
+        for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+            pedestrian_set.by_id[p_index]->random_number = draw_movement_random_number(pedestrian_set.by_id[p_index]);
+    }
+
     for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
     {
         Pedestrian current_pedestrian = pedestrian_set.list[p_index];
@@ -171,7 +209,8 @@ void evaluate_pedestrians_movements()
         if(current_pedestrian->state != MOVING || current_pedestrian->in_panic == true)
             continue;
 
-        Cell destination_cell = find_smallest_cell(current_pedestrian->current, ! cli_args.always_move_to_lowest);
+        int random_number = is_list_sorted ? current_pedestrian->random_number : draw_movement_random_number(current_pedestrian);
+        Cell destination_cell = find_smallest_cell(current_pedestrian->current, ! cli_args.always_move_to_lowest, random_number);
 
         if(destination_cell.coordinates.lin == -1 && destination_cell.coordinates.col == -1)
         { 
@@ -192,6 +231,9 @@ void evaluate_pedestrians_movements()
 /**
  * Verifies the target cells of all pedestrians and identifies cases where multiple pedestrians aim to move to the same cell.
  * 
+ * @note The conflicts are ordered by the second smallest ID of each, the order in which they are found in the ID order, so the 
+ * random numbers drawn to solve them don't depend on the spatial sorting.
+ * 
  * @param pedestrian_conflicts A pointer to a pointer to a cell_conflict structure, representing the address of a list of cell_conflict structures. The function will create this list of conflicts and assign its pointer to the provided pointer. 
  * @param num_conflicts Pointer to a integer, where the number of conflicts will be stored.
  * @return Function_Status: FAILURE (0) or SUCCESS (1).
@@ -237,8 +279,8 @@ Function_Status identify_pedestrian_conflicts(Cell_Conflict *pedestrian_conflict
             Cell_Conflict current_conflict = &(conflict_list[conflict_number]);
 
             current_conflict->pedestrian_ids[0] = *target_cell;
-            current_conflict->pedestrian_ids[1] = current_pedestrian->id;
-            current_conflict->num_pedestrians = 2;
+            current_conflict->num_pedestrians = 1;
+            add_pedestrian_to_conflict(current_conflict, current_pedestrian->id);
 
             conflict_number++;
 
@@ -256,13 +298,14 @@ Function_Status identify_pedestrian_conflicts(Cell_Conflict *pedestrian_conflict
         int conflict_index = (*target_cell * -1) - 1;
         Cell_Conflict current_conflict = &(conflict_list[conflict_index]);
 
-        current_conflict->pedestrian_ids[current_conflict->num_pedestrians] = current_pedestrian->id;
-        current_conflict->num_pedestrians++;
-        // Adds the new id to the cell_conflict structure.
+        add_pedestrian_to_conflict(current_conflict, current_pedestrian->id);
     }
 
     deallocate_grid((void **) conflict_grid,cli_args.global_line_number);
 
+    if(conflict_number > 1)
+        qsort(conflict_list, conflict_number, sizeof(cell_conflict), compare_cell_conflicts);
+
     *pedestrian_conflicts = conflict_list;
     *num_conflicts = conflict_number;
 
@@ -295,7 +338,7 @@ Function_Status solve_pedestrian_conflicts(Cell_Conflict pedestrian_conflicts, i
             int pedestrian_id = current_conflict->pedestrian_ids[p_index] - 1;
 
             if(random_result != p_index)
-                pedestrian_set.list[pedestrian_id]->state = STOPPED;
+                pedestrian_set.by_id[pedestrian_id]->state = STOPPED;
         }
     }
 
@@ -330,21 +373,34 @@ void print_pedestrian_conflict_information(Cell_Conflict pedestrian_conflicts, i
 
 /**
  * Scans the pedestrian_position_grid to find adjacent pedestrians where their movement path cross (X movement) and resolves the conflict by allowing only one pedestrian to move.
+ * 
+ * @note The occupancy_bitmap is scanned one word at a time, so empty stretches of the environment are skipped and the 
+ * pedestrian IDs are only read for occupied cells.
  */
 void block_X_movement()
 {
     bool is_X_movement;
+    int last_column = cli_args.global_column_number - 2;
 
     //Except for the exits, there are no pedestrians at the boundaries of the environment, so no checks are performed there.
     for(int i = 1; i < cli_args.global_line_number - 1; i++) 
     {
-        for(int h = 1; h < cli_args.global_column_number - 1; h++)
+        for(int word_index = 0; word_index * BITS_PER_WORD <= last_column; word_index++)
         {
-            int first_pedestrian_id = pedestrian_position_grid[i][h];
-            if(first_pedestrian_id > 0) // there is a pedestrian on the cell
+            uint64_t occupied_cells = occupancy_bitmap[i][word_index];
+
+            while(occupied_cells != 0) // there are pedestrians on the word
             {
-                if(pedestrian_set.list[first_pedestrian_id - 1]->state != MOVING  || 
-                    pedestrian_set.list[first_pedestrian_id - 1]->in_panic == true)
+                int h = word_index * BITS_PER_WORD + __builtin_ctzll(occupied_cells);
+                occupied_cells &= occupied_cells - 1;
+
+                if(h < 1 || h > last_column)
+                    continue;
+
+                int first_pedestrian_id = pedestrian_position_grid[i][h];
+
+                if(pedestrian_set.by_id[first_pedestrian_id - 1]->state != MOVING  || 
+                    pedestrian_set.by_id[first_pedestrian_id - 1]->in_panic == true)
                     continue;
 
                 // X movements only occur between pedestrians located in vertically or horizontally adjacent cells,
@@ -352,26 +408,26 @@ void block_X_movement()
                 // have already been checked for X movements (or did not require any check), so only the cells located
                 // at [i][h+1] and [i+1][h] need to be verified.        
 
-                int second_pedestrian_id = pedestrian_position_grid[i][h + 1];
-                if(second_pedestrian_id > 0)  // there is a pedestrian on the cell
+                if(is_grid_bit_set(occupancy_bitmap, (Location){i, h + 1}))  // there is a pedestrian on the cell
                 {
-                    is_X_movement = are_pedestrian_paths_crossing(pedestrian_set.list[first_pedestrian_id- 1], pedestrian_set.list[second_pedestrian_id - 1]);
+                    int second_pedestrian_id = pedestrian_position_grid[i][h + 1];
+                    is_X_movement = are_pedestrian_paths_crossing(pedestrian_set.by_id[first_pedestrian_id - 1], pedestrian_set.by_id[second_pedestrian_id - 1]);
 
                     if(is_X_movement == true)
                     {
-                        solve_X_movement(pedestrian_set.list[first_pedestrian_id- 1], pedestrian_set.list[second_pedestrian_id - 1]);
+                        solve_X_movement(pedestrian_set.by_id[first_pedestrian_id - 1], pedestrian_set.by_id[second_pedestrian_id - 1]);
                         continue;
                     }
 
                 }
 
-                second_pedestrian_id = pedestrian_position_grid[i + 1][h];
-                if(second_pedestrian_id > 0) // there is a pedestrian on the cell
+                if(is_grid_bit_set(occupancy_bitmap, (Location){i + 1, h})) // there is a pedestrian on the cell
                 {
-                    is_X_movement = are_pedestrian_paths_crossing(pedestrian_set.list[first_pedestrian_id- 1], pedestrian_set.list[second_pedestrian_id - 1]);
+                    int second_pedestrian_id = pedestrian_position_grid[i + 1][h];
+                    is_X_movement = are_pedestrian_paths_crossing(pedestrian_set.by_id[first_pedestrian_id - 1], pedestrian_set.by_id[second_pedestrian_id - 1]);
 
                     if(is_X_movement == true)
-                        solve_X_movement(pedestrian_set.list[first_pedestrian_id- 1], pedestrian_set.list[second_pedestrian_id - 1]);
+                        solve_X_movement(pedestrian_set.by_id[first_pedestrian_id - 1], pedestrian_set.by_id[second_pedestrian_id - 1]);
 
                 }
             }
@@ -383,10 +439,13 @@ void block_X_movement()
  *  Pedestrians in MOVING state are moved to their target location (the target Location is copied to the current Location). Upon reaching an exit, their state changes to LEAVING; those already in an exit transition to GOT_OUT. This is how the movement of a pedestrian is done.
  * 
  * @note If the immediate_exit flag is on, the pedestrians go directly from MOVING to GOT_OUT when a exit is reached.
+ * @note The num_stalled_timesteps of the pedestrian_set is incremented if no pedestrian moves or leaves, and reset otherwise.
  * 
 */
 void apply_pedestrian_movement()
 {
+    bool has_progressed = false;
+
     for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
     {
         Pedestrian current_pedestrian = pedestrian_set.list[p_index];
@@ -394,11 +453,13 @@ void apply_pedestrian_movement()
         if(current_pedestrian->in_panic == true || current_pedestrian->state == GOT_OUT || current_pedestrian->state == STOPPED)
             continue; // Pedestrian is ignored
 
+        has_progressed = true;
+
         if(current_pedestrian->state == MOVING)
         {
             current_pedestrian->current = current_pedestrian->target;
 
-            if(exits_set.final_floor_field[current_pedestrian->current.lin][current_pedestrian->current.col] == EXIT_VALUE)
+            if(get_field_value(exits_set.final_floor_field, current_pedestrian->current.lin, current_pedestrian->current.col) == EXIT_VALUE)
             {
                 current_pedestrian->state = cli_args.immediate_exit ? GOT_OUT : LEAVING; 
                 // Leaving means the pedestrian will remain for a timestep before being removed from the environment.
@@ -407,6 +468,8 @@ void apply_pedestrian_movement()
         else if(current_pedestrian->state == LEAVING)
             current_pedestrian->state = GOT_OUT; // After a timestep in the exit the pedestrian is removed from the environment.
     }
+
+    pedestrian_set.num_stalled_timesteps = has_progressed ? 0 : pedestrian_set.num_stalled_timesteps + 1;
 }
 
 /**
@@ -426,11 +489,34 @@ bool is_environment_empty()
 }
 
 /**
- * Reset the pedestrian_position_grid and update it with the current position of all pedestrians still in the environment.
+ * Verifies if the pedestrians can never move again: no pedestrian moved or left in the last timestep and every pedestrian
+ * still in the environment is enclosed by walls and other pedestrians. The same state would then repeat in every following
+ * timestep, whatever the random numbers drawn.
+ * 
+ * @return bool, where True indicates that the environment is deadlocked and False otherwise.
+*/
+bool is_environment_deadlocked()
+{
+    if(pedestrian_set.num_stalled_timesteps == 0)
+        return false;
+
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+    {
+        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
+        if(current_pedestrian->state != GOT_OUT && ! is_cell_enclosed(current_pedestrian->current))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Reset the pedestrian_position_grid and the occupancy_bitmap and update them with the current position of all pedestrians still in the environment.
 */
 void update_pedestrian_position_grid()
 {
     reset_integer_grid(pedestrian_position_grid, cli_args.global_line_number, cli_args.global_column_number);
+    reset_bit_grid(occupancy_bitmap, cli_args.global_line_number, cli_args.global_column_number);
 
     for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
     {
@@ -440,6 +526,7 @@ void update_pedestrian_position_grid()
             continue;
 
         pedestrian_position_grid[current_pedestrian->current.lin][current_pedestrian->current.col] = current_pedestrian->id;
+        set_grid_bit(occupancy_bitmap, current_pedestrian->current);
         heatmap_grid[current_pedestrian->current.lin][current_pedestrian->current.col]++;
     }
 }
@@ -470,10 +557,18 @@ void reset_pedestrian_panic()
 
 /**
  * Reset all pedestrian structures to their original values, i.e., the state is set to MOVING and their current Location is set to the origin Location.
+ * 
+ * @note The pedestrian list is restored to the ID order, undoing any spatial sorting of the previous simulation.
 */
 void reset_pedestrians_structures()
 {
     reset_integer_grid(pedestrian_position_grid, cli_args.global_line_number, cli_args.global_column_number);
+    reset_bit_grid(occupancy_bitmap, cli_args.global_line_number, cli_args.global_column_number);
+
+    if(pedestrian_set.num_pedestrians > 0)
+        memcpy(pedestrian_set.list, pedestrian_set.by_id, sizeof(Pedestrian) * pedestrian_set.num_pedestrians);
+
+    pedestrian_set.num_stalled_timesteps = 0;
     
     for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
     {
@@ -484,7 +579,63 @@ void reset_pedestrians_structures()
         current_pedestrian->state = MOVING;
         current_pedestrian->in_panic = false;
         pedestrian_position_grid[current_pedestrian->current.lin][current_pedestrian->current.col] = current_pedestrian->id;
+        set_grid_bit(occupancy_bitmap, current_pedestrian->current);
+    }
+}
+
+/**
+ * Counts every pedestrian in the heatmap at their origin, as done when the pedestrian is created.
+ *
+ * @note Used when the pedestrians loaded from the environment file are reused by another sweep point or batch run, so that its
+ * heatmap is the same of a separate execution.
+*/
+void count_pedestrians_in_heatmap()
+{
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+    {
+        Location origin = pedestrian_set.by_id[p_index]->origin;
+        heatmap_grid[origin.lin][origin.col]++;
+    }
+}
+
+/**
+ * Sorts the pedestrian list along a Morton (Z-order) curve of the current pedestrian locations, so that pedestrians processed
+ * one after the other access nearby cells of the grids. Pedestrians that already left the environment are moved to the end of the list.
+ * 
+ * @note Only the processing order changes. The IDs, the pedestrian_position_grid and the by_id index remain the same, and the
+ * random numbers are still drawn in the ID order, so the results are the same obtained without sorting.
+ * 
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status sort_pedestrians_spatially()
+{
+    if(pedestrian_set.num_pedestrians == 0)
+        return SUCCESS;
+
+    spatial_key *keys = malloc(sizeof(spatial_key) * pedestrian_set.num_pedestrians);
+    if(keys == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of the keys for the spatial sorting of the pedestrians.\n");
+        return FAILURE;
+    }
+
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+    {
+        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
+
+        keys[p_index].pedestrian = current_pedestrian;
+        keys[p_index].code = current_pedestrian->state == GOT_OUT ? UINT64_MAX : 
+                             calculate_morton_code(current_pedestrian->current.lin, current_pedestrian->current.col);
     }
+
+    qsort(keys, pedestrian_set.num_pedestrians, sizeof(spatial_key), compare_spatial_keys);
+
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+        pedestrian_set.list[p_index] = keys[p_index].pedestrian;
+
+    free(keys);
+
+    return SUCCESS;
 }
 
 /* ---------------- ---------------- ---------------- ---------------- ---------------- */
@@ -648,4 +799,68 @@ static void solve_X_movement(Pedestrian first_pedestrian, Pedestrian second_pede
     if(cli_args.show_debug_information)
         printf("X Movement between %d and %d --> %d.\n", first_pedestrian->id, second_pedestrian->id, 
                                                          sorted_num < 50 ? first_pedestrian->id : second_pedestrian->id);
-}
\ No newline at end of file
+}
+
+/**
+ * Adds a pedestrian to a cell conflict, keeping the IDs of the conflict in increasing order. Therefore, the pedestrian 
+ * allowed to move doesn't depend on the order in which the pedestrians are processed.
+ * 
+ * @param conflict The conflict.
+ * @param pedestrian_id ID of the pedestrian to be added.
+*/
+static void add_pedestrian_to_conflict(Cell_Conflict conflict, int pedestrian_id)
+{
+    int p_index = conflict->num_pedestrians - 1;
+    for(; p_index >= 0 && conflict->pedestrian_ids[p_index] > pedestrian_id; p_index--)
+        conflict->pedestrian_ids[p_index + 1] = conflict->pedestrian_ids[p_index];
+
+    conflict->pedestrian_ids[p_index + 1] = pedestrian_id;
+    conflict->num_pedestrians++;
+}
+
+/**
+ * Draws the random number used by find_smallest_cell to determine the destination cell of a pedestrian, if it's used.
+ * 
+ * @param pedestrian A Pedestrian.
+ * @return The random number, or 0 if the pedestrian doesn't evaluate its movement or has no cell to choose from.
+*/
+static int draw_movement_random_number(Pedestrian pedestrian)
+{
+    if(pedestrian->state != MOVING || pedestrian->in_panic == true || ! has_candidate_cells(pedestrian->current, ! cli_args.always_move_to_lowest))
+        return 0;
+
+    return rand();
+}
+
+/**
+ * Compares two spatial keys by their Morton codes, using the pedestrian IDs to break ties. Used by qsort.
+ * 
+ * @param first Pointer to the first spatial_key.
+ * @param second Pointer to the second spatial_key.
+ * @return A negative integer if the first key comes first, a positive integer otherwise.
+*/
+static int compare_spatial_keys(const void *first, const void *second)
+{
+    const spatial_key *first_key = first;
+    const spatial_key *second_key = second;
+
+    if(first_key->code != second_key->code)
+        return first_key->code < second_key->code ? -1 : 1;
+
+    return first_key->pedestrian->id - second_key->pedestrian->id;
+}
+
+/**
+ * Compares two cell conflicts by the second smallest ID of their pedestrians, which is different in each conflict. Used by qsort.
+ * 
+ * @param first Pointer to the first cell_conflict.
+ * @param second Pointer to the second cell_conflict.
+ * @return A negative integer if the first conflict comes first, a positive integer otherwise.
+*/
+static int compare_cell_conflicts(const void *first, const void *second)
+{
+    const cell_conflict *first_conflict = first;
+    const cell_conflict *second_conflict = second;
+
+    return first_conflict->pedestrian_ids[1] - second_conflict->pedestrian_ids[1];
+}
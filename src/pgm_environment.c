@@ -0,0 +1,322 @@
+/*
+   File: pgm_environment.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module implements the loading of environments from PGM images (binary P5 or ASCII P2). The gray level of each pixel
+                is mapped to a wall, an exit, a pedestrian or an empty cell through the thresholds provided by the --pgm-thresholds option,
+                and square blocks of pixels may be merged into a single cell with the --pgm-downsample option. Connected exit cells form
+                a single exit.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<stdint.h>
+#include<stdbool.h>
+#include<ctype.h>
+#include<limits.h>
+
+#include"../headers/grid.h"
+#include"../headers/exit.h"
+#include"../headers/pedestrian.h"
+#include"../headers/initialization.h"
+#include"../headers/cli_processing.h"
+#include"../headers/pgm_environment.h"
+#include"../headers/shared_resources.h"
+
+// Classes of the cells, in increasing priority. A cell takes the class of highest priority among its pixels.
+enum Cell_Class {
+    CELL_EMPTY = 0,
+    CELL_PEDESTRIAN,
+    CELL_WALL,
+    CELL_EXIT,
+    CELL_GROUPED_EXIT // Exit cell already added to an exit.
+};
+
+typedef struct{
+    const char *content;
+    size_t size;
+    size_t position;
+}pgm_image;
+
+static bool extract_pgm_integer(pgm_image *image, int *value);
+static Function_Status classify_pgm_cells(pgm_image *image, bool is_binary, int width, int height, int maximum_value, unsigned char *cell_classes);
+static enum Cell_Class classify_pixel(int pixel_value, int maximum_value);
+static Function_Status group_exit_cells(unsigned char *cell_classes, Location first_cell, Location *cell_stack);
+
+/**
+ * Loads the environment from the content of a PGM image. The grids are filled directly from the pixels.
+ *
+ * @note A cell represents a square block of pgm_downsample_factor x pgm_downsample_factor pixels. The blocks at the right
+ * and bottom borders may be incomplete.
+ *
+ * @param content Content of the PGM image.
+ * @param size Size, in bytes, of the content.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status load_pgm_environment(const char *content, size_t size)
+{
+    pgm_image image = {content, size, 2};
+    int width, height, maximum_value;
+
+    if(size < 2 || content[0] != 'P' || (content[1] != '2' && content[1] != '5'))
+    {
+        fprintf(stderr, "The environment file isn't a PGM image (P2 or P5).\n");
+        return FAILURE;
+    }
+    bool is_binary = content[1] == '5';
+
+    if( ! extract_pgm_integer(&image, &width) || ! extract_pgm_integer(&image, &height) || ! extract_pgm_integer(&image, &maximum_value) ||
+        width <= 0 || height <= 0 || maximum_value <= 0 || maximum_value > UINT16_MAX)
+    {
+        fprintf(stderr, "Invalid PGM header. The width, height and maximum gray value (at most 65535) must be positive.\n");
+        return FAILURE;
+    }
+    image.position++; // A single whitespace separates the header from the pixels.
+
+    int factor = cli_args.pgm_downsample_factor;
+    cli_args.global_line_number = (height + factor - 1) / factor;
+    cli_args.global_column_number = (width + factor - 1) / factor;
+
+    if(allocate_grids() == FAILURE)
+        return FAILURE;
+
+    if(reset_integer_grid(pedestrian_position_grid, cli_args.global_line_number, cli_args.global_column_number) == FAILURE)
+        return FAILURE;
+
+    if(reset_bit_grid(occupancy_bitmap, cli_args.global_line_number, cli_args.global_column_number) == FAILURE)
+        return FAILURE;
+
+    size_t num_cells = (size_t) cli_args.global_line_number * cli_args.global_column_number;
+    unsigned char *cell_classes = calloc(num_cells, sizeof(unsigned char));
+    if(cell_classes == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of the cell classes of the PGM image.\n");
+        return FAILURE;
+    }
+
+    Location *cell_stack = NULL;
+    Function_Status returned_status = classify_pgm_cells(&image, is_binary, width, height, maximum_value, cell_classes);
+    if(returned_status == SUCCESS)
+    {
+        size_t num_exit_cells = 0;
+        for(size_t cell_index = 0; cell_index < num_cells; cell_index++)
+            num_exit_cells += cell_classes[cell_index] == CELL_EXIT;
+
+        // Each exit cell is stacked at most once while the exits are grouped.
+        cell_stack = malloc(sizeof(Location) * (num_exit_cells > 0 ? num_exit_cells : 1));
+        if(cell_stack == NULL)
+        {
+            fprintf(stderr, "Failure in the allocation of the stack used to group the exit cells.\n");
+            returned_status = FAILURE;
+        }
+    }
+
+    for(int i = 0; i < cli_args.global_line_number && returned_status == SUCCESS; i++)
+    {
+        for(int h = 0; h < cli_args.global_column_number && returned_status == SUCCESS; h++)
+        {
+            Location coordinates = {i, h};
+
+            switch(cell_classes[(size_t) i * cli_args.global_column_number + h])
+            {
+                case CELL_WALL:
+                case CELL_GROUPED_EXIT:
+                    environment_only_grid[i][h] = WALL_VALUE;
+                    break;
+                case CELL_EXIT:
+                    environment_only_grid[i][h] = WALL_VALUE;
+                    if(origin_uses_static_exits() == true)
+                        returned_status = group_exit_cells(cell_classes, coordinates, cell_stack);
+                    break;
+                case CELL_PEDESTRIAN:
+                    if(origin_uses_static_pedestrians() == true)
+                    {
+                        returned_status = add_new_pedestrian(coordinates);
+                        if(returned_status == FAILURE)
+                            break;
+
+                        pedestrian_position_grid[i][h] = pedestrian_set.list[pedestrian_set.num_pedestrians - 1]->id;
+                        set_grid_bit(occupancy_bitmap, coordinates);
+                    }
+                    break;
+            }
+        }
+    }
+
+    free(cell_classes);
+    free(cell_stack);
+
+    return returned_status;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Extracts a decimal integer from the current position of the PGM image, skipping any preceding whitespace and comments.
+ *
+ * @param image The PGM image.
+ * @param value Pointer to the integer where the extracted value will be stored.
+ * @return bool, where True indicates that an integer was extracted and False otherwise.
+*/
+static bool extract_pgm_integer(pgm_image *image, int *value)
+{
+    while(image->position < image->size)
+    {
+        char current_char = image->content[image->position];
+
+        if(current_char == '#') // Comments last until the end of the line.
+        {
+            while(image->position < image->size && image->content[image->position] != '\n')
+                image->position++;
+        }
+        else if(isspace((unsigned char) current_char))
+            image->position++;
+        else
+            break;
+    }
+
+    size_t first_digit = image->position;
+    long long int extracted_value = 0;
+    while(image->position < image->size && isdigit((unsigned char) image->content[image->position]))
+    {
+        if(extracted_value <= INT_MAX)
+            extracted_value = extracted_value * 10 + (image->content[image->position] - '0');
+        image->position++;
+    }
+
+    if(image->position == first_digit || extracted_value > INT_MAX)
+        return false;
+
+    *value = (int) extracted_value;
+
+    return true;
+}
+
+/**
+ * Reads every pixel of the PGM image, in the order they are stored, and determines the class of each cell.
+ *
+ * @param image The PGM image, positioned at its first pixel.
+ * @param is_binary Whether the pixels are stored in binary (P5) or as ASCII integers (P2).
+ * @param width Width of the image, in pixels.
+ * @param height Height of the image, in pixels.
+ * @param maximum_value Maximum gray value of the image.
+ * @param cell_classes Zeroed array where the class of each cell, line after line, will be stored.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status classify_pgm_cells(pgm_image *image, bool is_binary, int width, int height, int maximum_value, unsigned char *cell_classes)
+{
+    int factor = cli_args.pgm_downsample_factor;
+    int bytes_per_pixel = maximum_value > UCHAR_MAX ? 2 : 1;
+
+    if(is_binary && image->position + (size_t) width * height * bytes_per_pixel > image->size)
+    {
+        fprintf(stderr, "The PGM image has less pixels than its dimensions require.\n");
+        return FAILURE;
+    }
+
+    const unsigned char *pixels = (const unsigned char *) image->content + image->position;
+
+    for(int y = 0; y < height; y++)
+    {
+        unsigned char *class_line = cell_classes + (size_t) (y / factor) * cli_args.global_column_number;
+
+        for(int x = 0; x < width; x++)
+        {
+            int pixel_value;
+            if(! is_binary)
+            {
+                if(! extract_pgm_integer(image, &pixel_value))
+                {
+                    fprintf(stderr, "The PGM image has less pixels than its dimensions require.\n");
+                    return FAILURE;
+                }
+            }
+            else if(bytes_per_pixel == 1)
+                pixel_value = *(pixels++);
+            else
+            {
+                pixel_value = (pixels[0] << 8) | pixels[1]; // Most significant byte first.
+                pixels += 2;
+            }
+
+            enum Cell_Class pixel_class = classify_pixel(pixel_value, maximum_value);
+            if(pixel_class > class_line[x / factor])
+                class_line[x / factor] = pixel_class;
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Determines the class of a pixel. The gray value is scaled to the range 0 - 255 and compared with the thresholds: values
+ * below the first one are walls, below the second one are exits, below the third one are pedestrians, and the remaining ones are empty.
+ *
+ * @param pixel_value Gray value of the pixel.
+ * @param maximum_value Maximum gray value of the image.
+ * @return The class of the pixel.
+*/
+static enum Cell_Class classify_pixel(int pixel_value, int maximum_value)
+{
+    int scaled_value = (int) ((long long int) pixel_value * UCHAR_MAX / maximum_value);
+
+    if(scaled_value < cli_args.pgm_thresholds[0])
+        return CELL_WALL;
+    if(scaled_value < cli_args.pgm_thresholds[1])
+        return CELL_EXIT;
+    if(scaled_value < cli_args.pgm_thresholds[2])
+        return CELL_PEDESTRIAN;
+
+    return CELL_EMPTY;
+}
+
+/**
+ * Creates a new exit formed by the given exit cell and every exit cell connected to it, including diagonally.
+ *
+ * @param cell_classes Class of each cell, line after line. The exit cells added to the exit are marked as grouped.
+ * @param first_cell First exit cell of the exit.
+ * @param cell_stack Array with space for every exit cell of the environment, used as the stack of cells to be visited.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status group_exit_cells(unsigned char *cell_classes, Location first_cell, Location *cell_stack)
+{
+    if(add_new_exit(first_cell) == FAILURE)
+        return FAILURE;
+
+    Exit new_exit = exits_set.list[exits_set.num_exits - 1];
+    int stack_size = 0;
+
+    cell_classes[(size_t) first_cell.lin * cli_args.global_column_number + first_cell.col] = CELL_GROUPED_EXIT;
+    cell_stack[stack_size++] = first_cell;
+
+    while(stack_size > 0)
+    {
+        Location current = cell_stack[--stack_size];
+
+        for(int j = -1; j < 2; j++)
+        {
+            for(int k = -1; k < 2; k++)
+            {
+                Location neighbor = {current.lin + j, current.col + k};
+                if(! is_within_grid_lines(neighbor.lin) || ! is_within_grid_columns(neighbor.col))
+                    continue;
+
+                unsigned char *neighbor_class = &cell_classes[(size_t) neighbor.lin * cli_args.global_column_number + neighbor.col];
+                if(*neighbor_class != CELL_EXIT)
+                    continue;
+
+                *neighbor_class = CELL_GROUPED_EXIT;
+                environment_only_grid[neighbor.lin][neighbor.col] = WALL_VALUE;
+                if(expand_exit(new_exit, neighbor) == FAILURE)
+                    return FAILURE;
+
+                cell_stack[stack_size++] = neighbor;
+            }
+        }
+    }
+
+    return SUCCESS;
+}
@@ -0,0 +1,327 @@
+/*
+   File: pipeline.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module implements the pipeline that prepares the simulation sets ahead of the simulations. A background thread
+                loads the upcoming simulation sets and calculates their final floor fields into a bounded queue, while the main thread
+                takes the prepared sets, in order, and runs their simulations. Each thread has its own exits_set and wall_bitmap, which
+                are exchanged through the queue. With the thread pool, the sets that fit in the free slots are prepared together,
+                the most expensive first, and published in order as they are finished.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdbool.h>
+#include<pthread.h>
+
+#include"../headers/exit.h"
+#include"../headers/grid.h"
+#include"../headers/shard.h"
+#include"../headers/pipeline.h"
+#include"../headers/thread_pool.h"
+#include"../headers/connectivity.h"
+#include"../headers/cli_processing.h"
+#include"../headers/simulation_set.h"
+#include"../headers/shared_resources.h"
+
+typedef struct{
+    Exits_Set exits; // Exits and final floor field of the simulation set.
+    Bit_Grid wall_bitmap; // Walls of the final floor field. Exchanged with the bitmap of the main thread when the set is taken.
+    Function_Status status; // FAILURE (0), SUCCESS (1), INACCESSIBLE_EXIT(2) or UNREACHABLE_PEDESTRIANS (3), as returned by calculate_final_floor_field.
+    int set_index;
+    double expected_seconds; // Estimated time of the calculation of the final floor field.
+    bool is_ready; // The preparation is finished, but the set is only published after the sets before it.
+}prepared_set;
+
+typedef struct{
+    pthread_t producer;
+    bool is_running;
+    prepared_set *slots; // Circular queue of prepared simulation sets.
+    prepared_set **group; // Slots of the simulation sets prepared together, in the order their preparation starts.
+    int depth; // Number of slots of the queue.
+    int first_slot; // Slot of the next simulation set to be taken.
+    int num_prepared; // Number of prepared simulation sets not yet taken.
+    int num_sets; // Number of simulation sets to be prepared.
+    pthread_mutex_t lock;
+    pthread_cond_t set_prepared;
+    pthread_cond_t slot_released;
+    bool is_stopping;
+}simulation_set_pipeline;
+
+static simulation_set_pipeline pipeline = {.lock = PTHREAD_MUTEX_INITIALIZER, .set_prepared = PTHREAD_COND_INITIALIZER,
+                                           .slot_released = PTHREAD_COND_INITIALIZER};
+
+static const Exits_Set empty_exits_set = {{PRECISION_DOUBLE, LAYOUT_ROW_MAJOR, 0, 0, 0, NULL}, NULL, 0};
+
+static void *producer_routine(void *argument);
+static int load_simulation_set_group(int first_set_index, int first_slot, int max_group_size);
+static void load_prepared_simulation_set(int set_index, prepared_set *slot);
+static void prepare_simulation_set_task(void *task_data, int task_index);
+
+/**
+ * Starts the background thread that prepares the simulation sets.
+ *
+ * @param num_sets Number of simulation sets, prepared in the order of their indexes.
+ * @param depth Maximum number of simulation sets prepared ahead of the simulations.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status start_simulation_set_pipeline(int num_sets, int depth)
+{
+    pipeline.slots = calloc(depth, sizeof(prepared_set));
+    pipeline.group = malloc(sizeof(prepared_set *) * depth);
+    if(pipeline.slots == NULL || pipeline.group == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of the simulation set pipeline.\n");
+        free(pipeline.slots);
+        free(pipeline.group);
+        pipeline.slots = NULL;
+        pipeline.group = NULL;
+        return FAILURE;
+    }
+
+    pipeline.depth = depth;
+    pipeline.first_slot = 0;
+    pipeline.num_prepared = 0;
+    pipeline.num_sets = num_sets;
+    pipeline.is_stopping = false;
+
+    if(pthread_create(&pipeline.producer, NULL, producer_routine, NULL) != 0)
+    {
+        fprintf(stderr, "Failure in the creation of the thread of the simulation set pipeline.\n");
+        free(pipeline.slots);
+        free(pipeline.group);
+        pipeline.slots = NULL;
+        pipeline.group = NULL;
+        return FAILURE;
+    }
+
+    pipeline.is_running = true;
+
+    return SUCCESS;
+}
+
+/**
+ * Waits for the next prepared simulation set and makes it the active one, replacing the exits_set and the wall_bitmap.
+ *
+ * @note The exits of the previous simulation set must already be deallocated. Must be called at most once for each simulation set.
+ *
+ * @return Function_Status: FAILURE (0), SUCCESS (1), INACCESSIBLE_EXIT(2) or UNREACHABLE_PEDESTRIANS (3), as returned by
+ * calculate_final_floor_field for the simulation set.
+*/
+Function_Status take_prepared_simulation_set()
+{
+    pthread_mutex_lock(&pipeline.lock);
+    while(pipeline.num_prepared == 0)
+        pthread_cond_wait(&pipeline.set_prepared, &pipeline.lock);
+
+    prepared_set *slot = &pipeline.slots[pipeline.first_slot];
+    pthread_mutex_unlock(&pipeline.lock);
+
+    Bit_Grid previous_wall_bitmap = wall_bitmap;
+    exits_set = slot->exits;
+    wall_bitmap = slot->wall_bitmap;
+    slot->exits = empty_exits_set;
+    slot->wall_bitmap = previous_wall_bitmap; // Reused by the next simulation set prepared in the slot.
+    Function_Status returned_status = slot->status;
+
+    pthread_mutex_lock(&pipeline.lock);
+    slot->is_ready = false;
+    pipeline.first_slot = (pipeline.first_slot + 1) % pipeline.depth;
+    pipeline.num_prepared--;
+    pthread_cond_signal(&pipeline.slot_released);
+    pthread_mutex_unlock(&pipeline.lock);
+
+    return returned_status;
+}
+
+/**
+ * Stops the background thread, waiting for the simulation sets it is preparing, and deallocates the simulation sets not taken.
+*/
+void stop_simulation_set_pipeline()
+{
+    if(! pipeline.is_running)
+        return;
+
+    pthread_mutex_lock(&pipeline.lock);
+    pipeline.is_stopping = true;
+    pthread_cond_broadcast(&pipeline.slot_released);
+    pthread_mutex_unlock(&pipeline.lock);
+
+    pthread_join(pipeline.producer, NULL);
+    pipeline.is_running = false;
+
+    Exits_Set active_exits_set = exits_set;
+    for(int slot_index = 0; slot_index < pipeline.depth; slot_index++)
+    {
+        prepared_set *slot = &pipeline.slots[slot_index];
+
+        exits_set = slot->exits; // deallocate_exits only deallocates the exits_set of the calling thread.
+        deallocate_exits();
+        deallocate_grid((void **) slot->wall_bitmap, cli_args.global_line_number);
+    }
+    exits_set = active_exits_set;
+
+    free(pipeline.slots);
+    free(pipeline.group);
+    pipeline.slots = NULL;
+    pipeline.group = NULL;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Routine of the background thread, which prepares the simulation sets in order while there are free slots in the queue.
+ * A group of simulation sets with a failed preparation is the last one prepared.
+ *
+ * @note Without the thread pool, the simulation sets are prepared one at a time, with the floor fields of their exits calculated
+ * in parallel. Otherwise, every simulation set that fits in the free slots is prepared as a task of the pool, since a single set
+ * rarely has enough exits to keep the threads busy.
+ *
+ * @param argument Unused.
+ * @return NULL.
+*/
+static void *producer_routine(void *argument)
+{
+    int set_index = 0;
+    while(set_index < pipeline.num_sets)
+    {
+        pthread_mutex_lock(&pipeline.lock);
+        while(pipeline.num_prepared == pipeline.depth && ! pipeline.is_stopping)
+            pthread_cond_wait(&pipeline.slot_released, &pipeline.lock);
+
+        if(pipeline.is_stopping)
+        {
+            pthread_mutex_unlock(&pipeline.lock);
+            break;
+        }
+
+        // Slots after the prepared ones aren't accessed by the main thread.
+        int first_slot = (pipeline.first_slot + pipeline.num_prepared) % pipeline.depth;
+        int max_group_size = is_thread_pool_active() ? pipeline.depth - pipeline.num_prepared : 1;
+        pthread_mutex_unlock(&pipeline.lock);
+
+        if(max_group_size > pipeline.num_sets - set_index)
+            max_group_size = pipeline.num_sets - set_index;
+
+        int group_size = load_simulation_set_group(set_index, first_slot, max_group_size);
+        run_parallel_tasks(prepare_simulation_set_task, pipeline.group, group_size);
+
+        bool has_failed = false;
+        for(int group_index = 0; group_index < group_size; group_index++)
+            has_failed = has_failed || pipeline.group[group_index]->status == FAILURE;
+
+        if(has_failed)
+            break;
+
+        set_index += group_size;
+    }
+
+    return NULL;
+}
+
+/**
+ * Loads the next simulation sets into consecutive free slots of the queue and orders them by the estimated time of their final
+ * floor fields, longest first, so that the most expensive sets aren't left to the end of the group while the other threads are
+ * idle. The loading stops at the first simulation set that fails to load.
+ *
+ * @param first_set_index Index of the first simulation set of the group.
+ * @param first_slot Slot of the first simulation set of the group.
+ * @param max_group_size Maximum number of simulation sets of the group.
+ * @return The number of loaded simulation sets, whose slots are stored in pipeline.group.
+*/
+static int load_simulation_set_group(int first_set_index, int first_slot, int max_group_size)
+{
+    int group_size = 0;
+    while(group_size < max_group_size)
+    {
+        prepared_set *slot = &pipeline.slots[(first_slot + group_size) % pipeline.depth];
+        load_prepared_simulation_set(first_set_index + group_size, slot);
+
+        // Insertion sort, since the groups are at most as large as the queue.
+        int insertion_index = group_size;
+        while(insertion_index > 0 && pipeline.group[insertion_index - 1]->expected_seconds < slot->expected_seconds)
+        {
+            pipeline.group[insertion_index] = pipeline.group[insertion_index - 1];
+            insertion_index--;
+        }
+
+        pipeline.group[insertion_index] = slot;
+        group_size++;
+
+        if(slot->status == FAILURE)
+            break;
+    }
+
+    return group_size;
+}
+
+/**
+ * Loads a simulation set into a slot of the queue and estimates the time of its final floor field.
+ *
+ * @note Simulation sets of other shards aren't simulated, so only their connectivity is verified, and their estimated time is 0.
+ *
+ * @param set_index Index of the simulation set.
+ * @param slot Free slot of the queue, whose status is FAILURE if the simulation set couldn't be loaded.
+*/
+static void load_prepared_simulation_set(int set_index, prepared_set *slot)
+{
+    slot->exits = empty_exits_set;
+    slot->status = FAILURE;
+    slot->set_index = set_index;
+    slot->expected_seconds = 0;
+
+    if(slot->wall_bitmap == NULL)
+    {
+        slot->wall_bitmap = allocate_bit_grid(cli_args.global_line_number, cli_args.global_column_number);
+        if(slot->wall_bitmap == NULL)
+        {
+            fprintf(stderr, "Failure in the allocation of the wall bitmap of a prepared simulation set.\n");
+            return;
+        }
+    }
+
+    slot->status = load_simulation_set(set_index);
+    if(slot->status == SUCCESS && is_set_in_shard(set_index))
+        slot->expected_seconds = estimate_final_floor_field_seconds();
+
+    slot->exits = exits_set;
+    exits_set = empty_exits_set;
+}
+
+/**
+ * Calculates the final floor field of a loaded simulation set, storing the result in its slot, and publishes the prepared sets
+ * that are next in order. Used as a task of the thread pool.
+ *
+ * @param task_data The slots of the group of simulation sets.
+ * @param task_index Index of the simulation set in the group.
+*/
+static void prepare_simulation_set_task(void *task_data, int task_index)
+{
+    prepared_set *slot = ((prepared_set **) task_data)[task_index];
+
+    if(slot->status == SUCCESS)
+    {
+        exits_set = slot->exits;
+        wall_bitmap = slot->wall_bitmap;
+
+        if(! is_set_in_shard(slot->set_index))
+            slot->status = verify_simulation_set_connectivity(); // Not simulated, so its floor field isn't needed.
+        else
+            slot->status = calculate_final_floor_field();
+
+        slot->exits = exits_set;
+        exits_set = empty_exits_set;
+        wall_bitmap = NULL;
+    }
+
+    pthread_mutex_lock(&pipeline.lock);
+    slot->is_ready = true;
+    while(pipeline.num_prepared < pipeline.depth && pipeline.slots[(pipeline.first_slot + pipeline.num_prepared) % pipeline.depth].is_ready)
+    {
+        pipeline.num_prepared++;
+        pthread_cond_signal(&pipeline.set_prepared);
+    }
+    pthread_mutex_unlock(&pipeline.lock);
+}
@@ -37,14 +37,15 @@ void print_full_command(FILE *output_stream)
  * @note The value of each position of the grid is divided by the number of simulations in order to achieve the mean of all simulations.
  * 
  * @param output_stream Stream where the data will be written.
+ * @param num_simulations Number of simulations accumulated in the heatmap grid.
 */
-void print_heatmap(FILE *output_stream)
+void print_heatmap(FILE *output_stream, int num_simulations)
 {
 	if(output_stream != NULL)
 	{
 		for(int i = 0; i < cli_args.global_line_number; i++){
 			for(int h = 0; h < cli_args.global_column_number; h++)
-				fprintf(output_stream, "%.2lf ", (double) heatmap_grid[i][h] / (double) cli_args.num_simulations);
+				fprintf(output_stream, "%.2lf ", (double) heatmap_grid[i][h] / (double) num_simulations);
 
 			fprintf(output_stream,"\n");
 		}
@@ -75,9 +76,9 @@ void print_pedestrian_position_grid(FILE *output_stream, int simulation_number,
 			{
 				if(pedestrian_position_grid[i][h] != 0)
 					fprintf(output_stream,"👤");
-				else if(exits_set.final_floor_field[i][h] == EXIT_VALUE)
+				else if(get_field_value(exits_set.final_floor_field, i, h) == EXIT_VALUE)
 					fprintf(output_stream,"🚪");
-				else if(exits_set.final_floor_field[i][h] == WALL_VALUE)
+				else if(is_field_wall(exits_set.final_floor_field, i, h))
 					fprintf(output_stream,"🧱");
 				else if(pedestrian_position_grid[i][h] == 0)
 					fprintf(output_stream,"⬛");
@@ -126,6 +127,26 @@ void print_double_grid(Double_Grid double_grid)
 }
 
 
+/**
+ * Print the field grid to stdout.
+ * 
+ * @param field_grid Field grid to be printed.
+*/
+void print_field_grid(Field_Grid field_grid)
+{
+	for(int i = 0; i < cli_args.global_line_number; i++){
+		for(int h = 0; h < cli_args.global_column_number; h++){
+			double value = get_field_value(field_grid, i, h);
+			if(value >= 1000.0)
+				printf("%.0lf\t", value);
+			else
+				printf("%5.1lf\t", value);
+		}
+		printf("\n\n");
+	}
+	printf("\n");
+}
+
 /**
  * Print information about the exits of a simulation set.
  * 
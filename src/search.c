@@ -0,0 +1,447 @@
+/*
+   File: search.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-19
+   Description: This module implements the search for the best simulation sets of the auxiliary file, i.e., the exit configurations
+                with the smallest mean number of timesteps. Instead of running the same number of simulations for every simulation
+                set, the simulations are spent on the simulation sets that are still candidates to be the best ones, as indicated by
+                the simulations already run or by a lower bound of the number of timesteps obtained from the final floor field.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<math.h>
+
+#include"../headers/exit.h"
+#include"../headers/grid.h"
+#include"../headers/pedestrian.h"
+#include"../headers/search.h"
+#include"../headers/statistics.h"
+#include"../headers/simulation.h"
+#include"../headers/cli_processing.h"
+#include"../headers/simulation_set.h"
+#include"../headers/printing_utilities.h"
+#include"../headers/shared_resources.h"
+
+typedef struct{
+    int set_index;
+    Function_Status status; // As returned by calculate_final_floor_field. Only simulation sets with SUCCESS are simulated.
+    int lower_bound; // Lower bound of the number of timesteps of any simulation of the simulation set.
+    Sample_Statistics statistics; // Statistics of the simulations not interrupted.
+    int num_simulations_run;
+    int last_round; // Last round in which the simulation set was simulated.
+}candidate_set;
+
+static Function_Status prepare_candidate_set(candidate_set *candidate);
+static Function_Status simulate_candidate_set(candidate_set *candidate, int num_simulations, int round, int first_seed);
+static Function_Status print_ranking(FILE *output_file, candidate_set *candidates, int num_candidates);
+static int calculate_lower_bound();
+static int calculate_distance_bound(int num_pedestrians);
+static int compare_candidate_sets(const void *first, const void *second);
+static int compare_lower_bounds(const void *first, const void *second);
+static int compare_integers(const void *first, const void *second);
+
+/**
+ * Searches for the best simulation sets by successive halving. In the first round, every simulation set runs --simu simulations.
+ * After each round, the worst half of the simulation sets is discarded and the number of simulations of the remaining sets is
+ * doubled, until the last round or until a single simulation set remains. The simulation sets are then ranked: first those
+ * simulated in later rounds and, among them, those with smaller mean numbers of timesteps.
+ *
+ * @note Common random numbers are used: the n-th simulation of every simulation set uses the same seed, so the simulation sets
+ * are compared under the same random conditions.
+ *
+ * @param output_file Stream where the ranking will be written.
+ * @param num_sets Number of simulation sets.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status run_successive_halving(FILE *output_file, int num_sets)
+{
+    candidate_set *candidates = calloc(num_sets, sizeof(candidate_set));
+    if(candidates == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of the candidate simulation sets.\n");
+        return FAILURE;
+    }
+
+    for(int set_index = 0; set_index < num_sets; set_index++)
+        candidates[set_index] = (candidate_set) {set_index, SUCCESS, -1, {0, 0, 0}, 0, 0};
+
+    int num_candidates = num_sets; // Candidates still being simulated, kept at the beginning of the array.
+    int first_seed = cli_args.seed;
+    int num_simulations = cli_args.num_simulations;
+
+    for(int round = 1; round <= cli_args.successive_halving_rounds && num_candidates > 0; round++, num_simulations *= 2)
+    {
+        for(int candidate_index = 0; candidate_index < num_candidates; candidate_index++)
+        {
+            if(simulate_candidate_set(&candidates[candidate_index], num_simulations, round, first_seed) == FAILURE)
+            {
+                free(candidates);
+                return FAILURE;
+            }
+
+            print_execution_status(candidate_index, num_candidates);
+        }
+
+        qsort(candidates, num_candidates, sizeof(candidate_set), compare_candidate_sets);
+
+        while(num_candidates > 0 && candidates[num_candidates - 1].status != SUCCESS)
+            num_candidates--; // Rejected simulation sets are sorted after the simulated ones.
+
+        if(num_candidates == 1)
+            break;
+
+        num_candidates = (num_candidates + 1) / 2;
+    }
+
+    qsort(candidates, num_sets, sizeof(candidate_set), compare_candidate_sets);
+
+    Function_Status returned_status = print_ranking(output_file, candidates, num_sets);
+    free(candidates);
+
+    return returned_status;
+}
+
+/**
+ * Searches for the best simulation sets by branch and bound. A lower bound of the number of timesteps is calculated for every
+ * simulation set from its final floor field, and the simulation sets are simulated (--simu simulations each) in increasing order
+ * of their lower bounds. A simulation set whose lower bound exceeds the smallest mean number of timesteps measured so far isn't
+ * simulated, and neither are the ones after it. The simulation sets are then ranked: first the simulated ones, by mean
+ * number of timesteps, and then the skipped ones, by lower bound.
+ *
+ * @note The lower bound is the largest of two bounds. The distance bound is the number of movements needed by the pedestrian
+ * farthest from the exits, considering only the distances given by the floor field. When the pedestrians are randomly placed,
+ * it considers the cell with the smallest distance that the farthest pedestrian could be placed at. The capacity bound is the
+ * number of timesteps needed to get all pedestrians through the exit cells, one pedestrian per cell at a time.
+ * @note Common random numbers are used, as in the successive halving.
+ *
+ * @param output_file Stream where the ranking will be written.
+ * @param num_sets Number of simulation sets.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status run_branch_and_bound(FILE *output_file, int num_sets)
+{
+    candidate_set *candidates = calloc(num_sets, sizeof(candidate_set));
+    if(candidates == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of the candidate simulation sets.\n");
+        return FAILURE;
+    }
+
+    for(int set_index = 0; set_index < num_sets; set_index++)
+    {
+        candidates[set_index] = (candidate_set) {set_index, SUCCESS, -1, {0, 0, 0}, 0, 0};
+
+        if(prepare_candidate_set(&candidates[set_index]) == FAILURE)
+        {
+            free(candidates);
+            return FAILURE;
+        }
+
+        deallocate_exits();
+    }
+
+    qsort(candidates, num_sets, sizeof(candidate_set), compare_lower_bounds);
+
+    double best_mean = INFINITY;
+    int first_seed = cli_args.seed;
+
+    for(int candidate_index = 0; candidate_index < num_sets; candidate_index++)
+    {
+        candidate_set *candidate = &candidates[candidate_index];
+        if(candidate->status != SUCCESS || candidate->lower_bound > best_mean)
+            break; // The remaining simulation sets are rejected or have even greater lower bounds.
+
+        if(simulate_candidate_set(candidate, cli_args.num_simulations, 1, first_seed) == FAILURE)
+        {
+            free(candidates);
+            return FAILURE;
+        }
+
+        // Means without the interrupted simulations would be underestimated.
+        if(candidate->statistics.num_samples == candidate->num_simulations_run && candidate->statistics.mean < best_mean)
+            best_mean = candidate->statistics.mean;
+
+        print_execution_status(candidate_index, num_sets);
+    }
+
+    qsort(candidates, num_sets, sizeof(candidate_set), compare_candidate_sets);
+
+    Function_Status returned_status = print_ranking(output_file, candidates, num_sets);
+    free(candidates);
+
+    return returned_status;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Loads a candidate simulation set, calculates its final floor field and, if it isn't rejected, its lower bound.
+ *
+ * @note The simulation set remains loaded when this function returns, and its exits must be deallocated.
+ *
+ * @param candidate Pointer to the candidate simulation set.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status prepare_candidate_set(candidate_set *candidate)
+{
+    if(load_simulation_set(candidate->set_index) == FAILURE)
+        return FAILURE;
+
+    candidate->status = calculate_final_floor_field();
+    if(candidate->status == FAILURE)
+        return FAILURE;
+
+    if(candidate->status == SUCCESS)
+    {
+        candidate->lower_bound = calculate_lower_bound();
+        if(candidate->lower_bound < 0)
+            return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Runs the simulations a candidate simulation set lacks to reach the given number of simulations.
+ *
+ * @param candidate Pointer to the candidate simulation set.
+ * @param num_simulations Number of simulations the candidate must have after this round.
+ * @param round Current round.
+ * @param first_seed Seed of the first simulation of every simulation set.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status simulate_candidate_set(candidate_set *candidate, int num_simulations, int round, int first_seed)
+{
+    if(prepare_candidate_set(candidate) == FAILURE)
+        return FAILURE;
+
+    if(candidate->status == SUCCESS)
+    {
+        int num_simulations_run = 0;
+        cli_args.seed = first_seed + candidate->num_simulations_run; // Continues the sequence of seeds shared by all simulation sets.
+
+        if(run_simulations(NULL, num_simulations - candidate->num_simulations_run, &candidate->statistics, &num_simulations_run) == FAILURE)
+            return FAILURE;
+
+        candidate->num_simulations_run += num_simulations_run;
+        candidate->last_round = round;
+    }
+
+    deallocate_exits();
+
+    return SUCCESS;
+}
+
+/**
+ * Prints the ranking of the simulation sets, one per line, with the statistics of their number of timesteps and their exits.
+ * Statistics that can't be calculated, as those of the rejected simulation sets (printed at the end), are printed as -1.
+ *
+ * @param output_file Stream where the ranking will be written.
+ * @param candidates Simulation sets, already ranked.
+ * @param num_candidates Number of simulation sets.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status print_ranking(FILE *output_file, candidate_set *candidates, int num_candidates)
+{
+    fprintf(output_file, "Rank Set Round Lower_bound Simulations Interrupted Mean Standard_deviation CI_half_width\n");
+
+    for(int candidate_index = 0; candidate_index < num_candidates; candidate_index++)
+    {
+        candidate_set *candidate = &candidates[candidate_index];
+
+        if(candidate->statistics.num_samples >= 2)
+        {
+            fprintf(output_file, "%d %d %d %d %d %d %.2lf %.2lf %.2lf ", candidate_index + 1, candidate->set_index + 1, candidate->last_round,
+                    candidate->lower_bound, candidate->num_simulations_run, candidate->num_simulations_run - candidate->statistics.num_samples,
+                    candidate->statistics.mean, calculate_standard_deviation(candidate->statistics),
+                    calculate_confidence_half_width(candidate->statistics));
+        }
+        else if(candidate->statistics.num_samples == 1)
+        {
+            fprintf(output_file, "%d %d %d %d %d %d %.2lf -1 -1 ", candidate_index + 1, candidate->set_index + 1, candidate->last_round,
+                    candidate->lower_bound, candidate->num_simulations_run, candidate->num_simulations_run - 1, candidate->statistics.mean);
+        }
+        else
+        {
+            fprintf(output_file, "%d %d %d %d %d %d -1 -1 -1 ", candidate_index + 1, candidate->set_index + 1, candidate->last_round,
+                    candidate->lower_bound, candidate->num_simulations_run, candidate->num_simulations_run - candidate->statistics.num_samples);
+        }
+
+        if(load_simulation_set(candidate->set_index) == FAILURE)
+            return FAILURE;
+
+        print_simulation_set_information(output_file);
+        deallocate_exits();
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Calculates a lower bound of the number of timesteps of any simulation of the loaded simulation set, as the largest of the
+ * distance bound and the capacity bound.
+ *
+ * @note The bounds hold whatever happens during the simulations (panic, conflicts and pedestrians waiting for others), as
+ * they assume that every pedestrian moves in every timestep.
+ *
+ * @return The lower bound, or -1 in case of failure.
+*/
+static int calculate_lower_bound()
+{
+    int num_pedestrians = origin_uses_static_pedestrians() ? pedestrian_set.num_pedestrians : cli_args.total_num_pedestrians;
+
+    int num_exit_cells = 0;
+    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+        num_exit_cells += exits_set.list[exit_index]->width;
+
+    if(num_pedestrians == 0 || num_exit_cells == 0)
+        return 0;
+
+    // Without --immediate-exit, a pedestrian stays a timestep in the exit cell, which can only receive another pedestrian in the following one.
+    int timesteps_per_pedestrian = cli_args.immediate_exit ? 1 : 2;
+    int capacity_bound = (num_pedestrians + num_exit_cells - 1) / num_exit_cells * timesteps_per_pedestrian;
+
+    int distance_bound = calculate_distance_bound(num_pedestrians);
+    if(distance_bound < 0)
+        return -1;
+
+    return distance_bound > capacity_bound ? distance_bound : capacity_bound;
+}
+
+/**
+ * Calculates the number of timesteps needed by the pedestrian farthest from the exits to leave the environment, if it could move
+ * in every timestep. A movement covers, in the floor field, the largest of the orthogonal and diagonal distances.
+ *
+ * @note With randomly placed pedestrians, the farthest pedestrian is at least as far as the num_pedestrians-th closest cell where
+ * a pedestrian may be placed.
+ *
+ * @param num_pedestrians Number of pedestrians in the environment.
+ * @return The distance bound, or -1 in case of failure.
+*/
+static int calculate_distance_bound(int num_pedestrians)
+{
+    int exit_units = cli_args.diagonal_denominator;
+    int largest_movement = cli_args.diagonal_numerator > cli_args.diagonal_denominator ? cli_args.diagonal_numerator : cli_args.diagonal_denominator;
+    int farthest_distance = 0;
+
+    if(origin_uses_static_pedestrians() == true)
+    {
+        for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+        {
+            Location origin = pedestrian_set.list[p_index]->origin;
+            int distance = get_field_units(exits_set.final_floor_field, origin.lin, origin.col) - exit_units;
+
+            if(distance > farthest_distance)
+                farthest_distance = distance;
+        }
+    }
+    else
+    {
+        int *distances = malloc(sizeof(int) * (size_t) cli_args.global_line_number * cli_args.global_column_number);
+        if(distances == NULL)
+        {
+            fprintf(stderr, "Failure in the allocation of the distances for the lower bound of the simulation set.\n");
+            return -1;
+        }
+
+        // The same cells considered by insert_pedestrians_at_random.
+        int num_cells = 0;
+        for(int i = 1; i < cli_args.global_line_number; i++)
+        {
+            for(int h = 1; h < cli_args.global_column_number; h++)
+            {
+                int units = get_field_units(exits_set.final_floor_field, i, h);
+                if(units == exit_units || units == WALL_UNITS || units == 0 || (cli_args.varas_fig7 == true && (h == 1 || h == 2)))
+                    continue;
+
+                distances[num_cells++] = units - exit_units;
+            }
+        }
+
+        if(num_cells > 0)
+        {
+            qsort(distances, num_cells, sizeof(int), compare_integers);
+            farthest_distance = distances[(num_pedestrians < num_cells ? num_pedestrians : num_cells) - 1];
+        }
+
+        free(distances);
+    }
+
+    int num_movements = (farthest_distance + largest_movement - 1) / largest_movement;
+
+    return cli_args.immediate_exit ? num_movements : num_movements + 1;
+}
+
+/**
+ * Compares two candidate simulation sets for the ranking: the simulated sets come first, then those simulated in later rounds,
+ * those with fewer interrupted simulations, those with smaller mean numbers of timesteps and those with smaller lower bounds.
+ * Ties keep the order of the auxiliary file.
+ *
+ * @param first Pointer to the first candidate_set.
+ * @param second Pointer to the second candidate_set.
+ * @return A negative integer if the first candidate is better, a positive integer if it is worse and 0 otherwise.
+*/
+static int compare_candidate_sets(const void *first, const void *second)
+{
+    const candidate_set *first_candidate = first;
+    const candidate_set *second_candidate = second;
+
+    if((first_candidate->status == SUCCESS) != (second_candidate->status == SUCCESS))
+        return first_candidate->status == SUCCESS ? -1 : 1;
+
+    if(first_candidate->last_round != second_candidate->last_round)
+        return second_candidate->last_round - first_candidate->last_round;
+
+    int first_interrupted = first_candidate->num_simulations_run - first_candidate->statistics.num_samples;
+    int second_interrupted = second_candidate->num_simulations_run - second_candidate->statistics.num_samples;
+    if(first_interrupted != second_interrupted)
+        return first_interrupted - second_interrupted;
+
+    if(first_candidate->statistics.mean != second_candidate->statistics.mean)
+        return first_candidate->statistics.mean < second_candidate->statistics.mean ? -1 : 1;
+
+    if(first_candidate->lower_bound != second_candidate->lower_bound)
+        return first_candidate->lower_bound - second_candidate->lower_bound;
+
+    return first_candidate->set_index - second_candidate->set_index;
+}
+
+/**
+ * Compares two candidate simulation sets by their lower bounds, placing the rejected ones at the end. Ties keep the order of the
+ * auxiliary file.
+ *
+ * @param first Pointer to the first candidate_set.
+ * @param second Pointer to the second candidate_set.
+ * @return A negative integer if the first candidate has a smaller lower bound, a positive integer if it has a greater one and 0 otherwise.
+*/
+static int compare_lower_bounds(const void *first, const void *second)
+{
+    const candidate_set *first_candidate = first;
+    const candidate_set *second_candidate = second;
+
+    if((first_candidate->status == SUCCESS) != (second_candidate->status == SUCCESS))
+        return first_candidate->status == SUCCESS ? -1 : 1;
+
+    if(first_candidate->lower_bound != second_candidate->lower_bound)
+        return first_candidate->lower_bound - second_candidate->lower_bound;
+
+    return first_candidate->set_index - second_candidate->set_index;
+}
+
+/**
+ * Compares two integers, in ascending order.
+ *
+ * @param first Pointer to the first integer.
+ * @param second Pointer to the second integer.
+ * @return A negative integer, 0 or a positive integer if the first integer is smaller, equal or greater than the second one.
+*/
+static int compare_integers(const void *first, const void *second)
+{
+    int first_value = *(const int *) first;
+    int second_value = *(const int *) second;
+
+    return (first_value > second_value) - (first_value < second_value);
+}
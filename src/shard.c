@@ -0,0 +1,252 @@
+/*
+   File: shard.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-19
+   Description: This module splits the simulation sets of the auxiliary file among several executions (shards), which may run on
+                different machines, and merges their output files back into the output of a single execution. The simulation
+                set of index k belongs to the shard k % N. Each shard still verifies the simulation sets of the other shards, so
+                the seeds of its simulation sets are the same as in a single execution, and writes a marker line before the
+                output of each of its simulation sets, used to merge the output files in the order of the simulation sets.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<stdbool.h>
+
+#include"../headers/shard.h"
+#include"../headers/initialization.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+#define MAX_SHARDS 256
+#define SHARD_SET_MARKER "Shard set: "
+#define HEADER_NUM_LINES 3 // Command, dashes and an empty line, as written by print_full_command.
+
+typedef struct{
+    FILE *file;
+    char *line; // Last line read from the file, a marker when there are simulation sets left.
+    size_t line_capacity;
+    bool is_finished;
+}shard_file;
+
+static Function_Status open_shard_files(shard_file *shards, int *num_shards);
+static Function_Status merge_shard_headers(FILE *output_file, shard_file *shards, int num_shards);
+static Function_Status copy_shard_set(FILE *output_file, shard_file *shard, int set_index);
+static bool read_shard_line(shard_file *shard);
+static void close_shard_files(shard_file *shards, int num_shards);
+
+/**
+ * Verifies if a simulation set belongs to the shard run by this execution.
+ *
+ * @param set_index Index of the simulation set.
+ * @return bool, where True indicates that the simulation set belongs to the shard, or that there is no sharding, and False otherwise.
+*/
+bool is_set_in_shard(int set_index)
+{
+    return cli_args.num_shards == 0 || set_index % cli_args.num_shards == cli_args.shard_index;
+}
+
+/**
+ * Writes the line that precedes the output of a simulation set of the shard.
+ *
+ * @param output_file Stream where the output data is written.
+ * @param set_index Index of the simulation set.
+*/
+void print_shard_set_marker(FILE *output_file, int set_index)
+{
+    fprintf(output_file, "%s%d\n", SHARD_SET_MARKER, set_index);
+}
+
+/**
+ * Merges the output files of the shards given with --merge-shards, in the order of their indexes, into the output of a single
+ * execution: the command without --shard, followed by the output of every simulation set in the order of the simulation sets.
+ *
+ * @param output_file Stream where the merged output will be written.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status merge_shard_files(FILE *output_file)
+{
+    shard_file shards[MAX_SHARDS];
+    int num_shards = 0;
+
+    if(open_shard_files(shards, &num_shards) == FAILURE)
+        return FAILURE;
+
+    Function_Status returned_status = merge_shard_headers(output_file, shards, num_shards);
+
+    // The simulation sets alternate among the shards, until the shard of the next simulation set has none left.
+    int set_index = 0;
+    while(returned_status == SUCCESS && ! shards[set_index % num_shards].is_finished)
+    {
+        returned_status = copy_shard_set(output_file, &shards[set_index % num_shards], set_index);
+        set_index++;
+    }
+
+    for(int shard_index = 0; shard_index < num_shards && returned_status == SUCCESS; shard_index++)
+    {
+        if(! shards[shard_index].is_finished)
+        {
+            fprintf(stderr, "The output file of the shard %d has simulation sets after the simulation set %d, which is missing.\n", shard_index, set_index);
+            returned_status = FAILURE;
+        }
+    }
+
+    close_shard_files(shards, num_shards);
+
+    return returned_status;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Opens the output files of the shards, given as a comma separated list relative to the output directory.
+ *
+ * @param shards Array where the opened files will be stored.
+ * @param num_shards Pointer to an integer, where the number of opened files will be stored.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status open_shard_files(shard_file *shards, int *num_shards)
+{
+    char filenames[sizeof(cli_args.merged_shard_filenames)];
+    strcpy(filenames, cli_args.merged_shard_filenames);
+
+    char *save_pointer = NULL;
+    for(char *filename = strtok_r(filenames, ",", &save_pointer); filename != NULL; filename = strtok_r(NULL, ",", &save_pointer))
+    {
+        if(*num_shards == MAX_SHARDS)
+        {
+            fprintf(stderr, "At most %d shards can be merged.\n", MAX_SHARDS);
+            close_shard_files(shards, *num_shards);
+            return FAILURE;
+        }
+
+        char complete_path[300];
+        snprintf(complete_path, sizeof(complete_path), "%s%s", output_path, filename);
+
+        shard_file *shard = &shards[*num_shards];
+        *shard = (shard_file) {fopen(complete_path, "r"), NULL, 0, false};
+        if(shard->file == NULL)
+        {
+            fprintf(stderr, "It was not possible to open the output file of the shard %d: %s.\n", *num_shards, complete_path);
+            close_shard_files(shards, *num_shards);
+            return FAILURE;
+        }
+
+        (*num_shards)++;
+    }
+
+    if(*num_shards == 0)
+    {
+        fprintf(stderr, "No output file of a shard was given to --merge-shards.\n");
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Verifies that each output file was written by the shard of its position, of as many shards as there are files, and writes
+ * the command of the first one without --shard.
+ *
+ * @param output_file Stream where the merged output will be written.
+ * @param shards The opened output files of the shards, left at the marker of their first simulation set.
+ * @param num_shards Number of shards.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status merge_shard_headers(FILE *output_file, shard_file *shards, int num_shards)
+{
+    for(int shard_index = 0; shard_index < num_shards; shard_index++)
+    {
+        shard_file *shard = &shards[shard_index];
+
+        char shard_option[50];
+        sprintf(shard_option, " --shard=%d/%d", shard_index, num_shards);
+
+        char *option_start = read_shard_line(shard) ? strstr(shard->line, shard_option) : NULL;
+        if(option_start == NULL || (option_start[strlen(shard_option)] != ' ' && option_start[strlen(shard_option)] != '\n'))
+        {
+            fprintf(stderr, "The output file of the shard %d wasn't written with%s.\n", shard_index, shard_option);
+            return FAILURE;
+        }
+
+        if(shard_index == 0)
+        {
+            fwrite(shard->line, 1, option_start - shard->line, output_file);
+            fputs(option_start + strlen(shard_option), output_file);
+        }
+
+        for(int line_index = 1; line_index < HEADER_NUM_LINES; line_index++)
+        {
+            if(! read_shard_line(shard))
+            {
+                fprintf(stderr, "The output file of the shard %d is incomplete.\n", shard_index);
+                return FAILURE;
+            }
+
+            if(shard_index == 0)
+                fputs(shard->line, output_file);
+        }
+
+        shard->is_finished = ! read_shard_line(shard);
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Copies the output of a simulation set from the output file of its shard, leaving the file at the marker of its next simulation set.
+ *
+ * @param output_file Stream where the merged output will be written.
+ * @param shard The output file of the shard of the simulation set, at the marker of the simulation set.
+ * @param set_index Index of the simulation set.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status copy_shard_set(FILE *output_file, shard_file *shard, int set_index)
+{
+    if(strncmp(shard->line, SHARD_SET_MARKER, strlen(SHARD_SET_MARKER)) != 0 || atoi(shard->line + strlen(SHARD_SET_MARKER)) != set_index)
+    {
+        fprintf(stderr, "The output of the simulation set %d wasn't found in the output file of its shard.\n", set_index);
+        return FAILURE;
+    }
+
+    while(read_shard_line(shard))
+    {
+        if(strncmp(shard->line, SHARD_SET_MARKER, strlen(SHARD_SET_MARKER)) == 0)
+            return SUCCESS;
+
+        fputs(shard->line, output_file);
+    }
+
+    shard->is_finished = true;
+
+    return SUCCESS;
+}
+
+/**
+ * Reads the next line of the output file of a shard.
+ *
+ * @param shard The output file of the shard.
+ * @return bool, where True indicates that a line was read and False that the end of the file was reached.
+*/
+static bool read_shard_line(shard_file *shard)
+{
+    return getline(&shard->line, &shard->line_capacity, shard->file) != -1;
+}
+
+/**
+ * Closes the output files of the shards.
+ *
+ * @param shards The opened output files of the shards.
+ * @param num_shards Number of opened files.
+*/
+static void close_shard_files(shard_file *shards, int num_shards)
+{
+    for(int shard_index = 0; shard_index < num_shards; shard_index++)
+    {
+        fclose(shards[shard_index].file);
+        free(shards[shard_index].line);
+    }
+}
@@ -33,7 +33,8 @@ bool origin_uses_auxiliary_data()
 bool origin_uses_static_pedestrians()
 {
     return cli_args.environment_origin == STRUCTURE_AND_PEDESTRIANS || 
-           cli_args.environment_origin == STRUCTURE_DOORS_AND_PEDESTRIANS;
+           cli_args.environment_origin == STRUCTURE_DOORS_AND_PEDESTRIANS ||
+           cli_args.environment_origin == PGM_IMAGE;
 }
 
 /**
@@ -44,5 +45,6 @@ bool origin_uses_static_pedestrians()
 bool origin_uses_static_exits()
 {
     return cli_args.environment_origin == STRUCTURE_AND_DOORS || 
-           cli_args.environment_origin == STRUCTURE_DOORS_AND_PEDESTRIANS;
+           cli_args.environment_origin == STRUCTURE_DOORS_AND_PEDESTRIANS ||
+           cli_args.environment_origin == PGM_IMAGE;
 }
@@ -0,0 +1,410 @@
+/*
+   File: simulation.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-19
+   Description: This module runs the simulation sets, one after another, and the simulations of the active simulation set, one
+                after another, timestep after timestep, until every pedestrian leaves the environment or the simulation is interrupted.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<unistd.h>
+
+#include"../headers/exit.h"
+#include"../headers/shard.h"
+#include"../headers/sweep.h"
+#include"../headers/search.h"
+#include"../headers/pipeline.h"
+#include"../headers/connectivity.h"
+#include"../headers/pedestrian.h"
+#include"../headers/memoization.h"
+#include"../headers/simulation_set.h"
+#include"../headers/statistics.h"
+#include"../headers/simulation.h"
+#include"../headers/cli_processing.h"
+#include"../headers/printing_utilities.h"
+#include"../headers/shared_resources.h"
+
+static Function_Status conflict_solving();
+static bool is_spatial_sort_due(int number_timesteps);
+static bool is_simulation_interrupted(int number_timesteps);
+static bool is_precision_reached(Sample_Statistics statistics);
+static Function_Status store_simulation_set_output(FILE *output_file, FILE *set_output_file, char **set_output, size_t *set_output_size, Function_Status status);
+
+/**
+ * Runs the simulations of the active simulation set, starting at the current seed, printing generated data if appropriate.
+ * 
+ * @note When --ci-half-width is given, the simulations stop as soon as the mean number of timesteps is estimated with the
+ * requested precision, after at least min_simulations and at most num_simulations simulations. The seed is always advanced
+ * by num_simulations, so the simulations run are the first ones that would be run without it.
+ * 
+ * @param output_file Stream where the output data will be written, or NULL if no data must be written.
+ * @param num_simulations Maximum number of simulations to be run.
+ * @param statistics Pointer to the statistics to which the number of timesteps of each simulation not interrupted is added.
+ * @param num_simulations_run Pointer to an integer, where the number of simulations run will be stored.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status run_simulations(FILE *output_file, int num_simulations, Sample_Statistics *statistics, int *num_simulations_run)
+{
+    int first_seed = cli_args.seed;
+    *num_simulations_run = 0;
+
+    for(int simu_index = 0; simu_index < num_simulations && ! is_precision_reached(*statistics); simu_index++, cli_args.seed++)
+    {
+        srand(cli_args.seed);
+
+        if(cli_args.show_debug_information)
+            print_field_grid(exits_set.final_floor_field);
+
+        if(origin_uses_static_pedestrians() == false)
+        {
+            if( insert_pedestrians_at_random(cli_args.total_num_pedestrians) == FAILURE)
+                return FAILURE;
+        }
+        
+        if(output_file != NULL && cli_args.output_format == OUTPUT_VISUALIZATION)
+            print_pedestrian_position_grid(output_file, simu_index, 0);
+
+        int number_timesteps = 0;
+        while(is_environment_empty() == false)
+        {
+            if(is_simulation_interrupted(number_timesteps))
+            {
+                number_timesteps = INTERRUPTED_SIMULATION;
+                break;
+            }
+
+            if(cli_args.show_debug_information)
+            {
+                print_int_grid(pedestrian_position_grid);
+                printf("\nTimestep %d.\n", number_timesteps + 1);
+            }
+            
+            evaluate_pedestrians_movements();
+            determine_pedestrians_in_panic();
+            
+            if(!cli_args.allow_X_movement)
+                block_X_movement(); // Runs when allow_X_movement is false.
+            
+            if(conflict_solving() == FAILURE)
+                return FAILURE;
+            
+            apply_pedestrian_movement();
+
+            update_pedestrian_position_grid();
+            reset_pedestrian_state();
+            reset_pedestrian_panic();
+            
+            number_timesteps++;
+
+            if(is_spatial_sort_due(number_timesteps) && sort_pedestrians_spatially() == FAILURE)
+                return FAILURE;
+
+            if(output_file != NULL && cli_args.output_format == OUTPUT_VISUALIZATION)
+            {
+                if(!cli_args.write_to_file)
+                    sleep(1);
+                    
+                print_pedestrian_position_grid(output_file, simu_index,number_timesteps);
+            }
+
+        }
+
+        if(origin_uses_static_pedestrians() == true)
+            reset_pedestrians_structures();
+        else
+            deallocate_pedestrians();
+
+        if(output_file != NULL && cli_args.output_format == OUTPUT_TIMESTEPS_COUNT)
+            fprintf(output_file,"%d ", number_timesteps);
+
+        if(number_timesteps != INTERRUPTED_SIMULATION)
+            add_sample(statistics, number_timesteps);
+        (*num_simulations_run)++;
+    }
+
+    cli_args.seed = first_seed + num_simulations; // The seeds of the next simulation set don't depend on the simulations run.
+
+    return SUCCESS;
+}
+
+/**
+ * Runs the simulations requested by the command line: a search for the best simulation sets, a parameter sweep or every
+ * simulation set, one after another.
+ *
+ * @param output_file Stream where the output data will be written.
+ * @param num_sets Number of simulation sets, where the origins that use static exits have a single one.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status run_requested_simulations(FILE *output_file, int num_sets)
+{
+    if(cli_args.use_branch_and_bound)
+        return run_branch_and_bound(output_file, num_sets);
+
+    if(cli_args.successive_halving_rounds > 0)
+        return run_successive_halving(output_file, num_sets);
+
+    if(is_sweep_active())
+        return run_sweep(output_file, num_sets);
+
+    return run_simulation_sets(output_file, num_sets);
+}
+
+/**
+ * Runs the simulations of every simulation set, one after another, writing their output in the order of the simulation sets.
+ *
+ * @param output_file Stream where the output data will be written.
+ * @param num_sets Number of simulation sets, where the origins that use static exits have a single one.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status run_simulation_sets(FILE *output_file, int num_sets)
+{
+    int set_index = 0;
+
+    bool is_pipelined = origin_uses_auxiliary_data() == true && cli_args.pipeline_depth > 0;
+    if(is_pipelined && start_simulation_set_pipeline(num_sets, cli_args.pipeline_depth) == FAILURE)
+        return FAILURE;
+
+    do
+    {
+        if(origin_uses_auxiliary_data() == true)
+        {
+            if(set_index == num_sets)
+                break; // All simulation sets were processed.
+
+            if(! is_pipelined && load_simulation_set(set_index) == FAILURE)
+                return FAILURE;
+        }
+
+        // With the pipeline, the simulation set was loaded and its floor field calculated in the background.
+        int returned_value = is_pipelined ? take_prepared_simulation_set() : SUCCESS;
+
+        // The simulation sets of the other shards are only verified, to advance the seed and the heatmap as they would be.
+        if(! is_set_in_shard(set_index))
+        {
+            if(! is_pipelined)
+                returned_value = verify_simulation_set_connectivity();
+
+            if(returned_value == FAILURE)
+                return FAILURE;
+
+            if(returned_value == SUCCESS)
+            {
+                cli_args.seed += cli_args.num_simulations;
+                if(cli_args.output_format == OUTPUT_HEATMAP)
+                    reset_integer_grid(heatmap_grid, cli_args.global_line_number, cli_args.global_column_number);
+            }
+
+            deallocate_exits();
+            set_index++;
+            continue;
+        }
+
+        if(cli_args.num_shards > 0)
+            print_shard_set_marker(output_file, set_index);
+
+        if(cli_args.show_simulation_set_info && returned_value != FAILURE)
+            print_simulation_set_information(output_file);
+
+        if(! is_pipelined)
+            returned_value = calculate_final_floor_field();
+
+        if( returned_value == FAILURE) 
+            return FAILURE;
+
+        // The output of a simulation set is kept, to be replayed for the later simulation sets with the same exits.
+        FILE *set_output_file = output_file;
+        char *set_output = NULL;
+        size_t set_output_size = 0;
+        if(cli_args.deduplicate_sets)
+        {
+            Memoized_Set memoized_set = NULL;
+            if(find_memoized_simulation_set(&memoized_set) == FAILURE)
+                return FAILURE;
+
+            if(memoized_set != NULL)
+            {
+                if(replay_memoized_simulation_set(memoized_set, output_file) == SUCCESS)
+                    cli_args.seed += cli_args.num_simulations; // As if the simulations were run.
+
+                deallocate_exits();
+                print_execution_status(set_index, num_sets);
+                set_index++;
+                continue;
+            }
+
+            set_output_file = open_memstream(&set_output, &set_output_size);
+            if(set_output_file == NULL)
+            {
+                fprintf(stderr, "Failure in the allocation of the output of a simulation set.\n");
+                return FAILURE;
+            }
+        }
+
+        if(returned_value == INACCESSIBLE_EXIT || returned_value == UNREACHABLE_PEDESTRIANS)
+        {
+            if(cli_args.output_format != OUTPUT_TIMESTEPS_COUNT && returned_value == INACCESSIBLE_EXIT)
+                fprintf(set_output_file, "At least one exit from the simulation set is inaccessible.\n");
+            else if(cli_args.output_format != OUTPUT_TIMESTEPS_COUNT)
+                fprintf(set_output_file, "At least one pedestrian can't reach any exit of the simulation set.\n");
+            else
+                print_placeholder(set_output_file, -1);
+
+            if(origin_uses_auxiliary_data() == true)
+                deallocate_exits();
+
+            if(cli_args.deduplicate_sets && store_simulation_set_output(output_file, set_output_file, &set_output, &set_output_size, returned_value) == FAILURE)
+                return FAILURE;
+
+            print_execution_status(set_index, num_sets);
+            set_index++;
+
+            if(origin_uses_static_exits() == true) // Only a single simulation set.
+                break;
+
+            continue;
+        }
+
+        if(cli_args.single_exit_flag == true && cli_args.output_format == OUTPUT_TIMESTEPS_COUNT && exits_set.num_exits == 1)
+        {
+            fprintf(set_output_file, "#1 "); // simulation set where the exit was combined with itself. Used to correct errors in the plotting program.
+        }
+
+        // The actual simulation happens here.
+        Sample_Statistics statistics = {0, 0, 0};
+        int num_simulations_run = 0;
+        if(run_simulations(set_output_file, cli_args.num_simulations, &statistics, &num_simulations_run) == FAILURE)
+            return FAILURE;
+
+        if(origin_uses_auxiliary_data() == true)
+            deallocate_exits();
+
+        if(cli_args.ci_half_width > 0)
+        {
+            if(cli_args.output_format == OUTPUT_TIMESTEPS_COUNT)
+                fprintf(set_output_file, "[%d]", num_simulations_run);
+            else
+                fprintf(set_output_file, "Number of simulations: %d\n", num_simulations_run);
+        }
+
+        if(cli_args.output_format == OUTPUT_TIMESTEPS_COUNT)
+            fprintf(set_output_file, "\n");
+
+        if(cli_args.output_format == OUTPUT_HEATMAP)
+        {
+            print_heatmap(set_output_file, num_simulations_run);        
+            reset_integer_grid(heatmap_grid, cli_args.global_line_number, cli_args.global_column_number);
+        }
+
+        if(cli_args.deduplicate_sets && store_simulation_set_output(output_file, set_output_file, &set_output, &set_output_size, SUCCESS) == FAILURE)
+            return FAILURE;
+
+        print_execution_status(set_index, num_sets);
+        set_index++;
+
+        if(origin_uses_static_exits() == true) // Only a single simulation set.
+            break;
+
+    }while(true);
+
+    stop_simulation_set_pipeline();
+    deallocate_memoized_simulation_sets(); // The output of a simulation set depends on the other parameters.
+
+    return SUCCESS;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Calls the necessary functions to identify and solve conflicts between pedestrians.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status conflict_solving()
+{
+    Cell_Conflict pedestrian_conflicts = NULL;
+    int num_conflicts = 0;
+
+    if(identify_pedestrian_conflicts(&pedestrian_conflicts, &num_conflicts) == FAILURE)
+        return FAILURE;                
+
+    if(solve_pedestrian_conflicts(pedestrian_conflicts, num_conflicts) == FAILURE)
+        return FAILURE;
+
+    if(cli_args.show_debug_information)
+        print_pedestrian_conflict_information(pedestrian_conflicts, num_conflicts);
+
+    free(pedestrian_conflicts);
+
+    return SUCCESS;
+}
+
+/**
+ * Verifies if the pedestrians must be spatially sorted after the given number of timesteps.
+ *
+ * @param number_timesteps Number of timesteps already run by the active simulation.
+ * @return bool, where True indicates that the pedestrians must be sorted and False otherwise.
+*/
+static bool is_spatial_sort_due(int number_timesteps)
+{
+    return cli_args.spatial_sort_interval > 0 && number_timesteps % cli_args.spatial_sort_interval == 0;
+}
+
+/**
+ * Verifies if the mean number of timesteps of the simulation set is already estimated with the precision requested by
+ * --ci-half-width, so that no more simulations are needed.
+ *
+ * @param statistics Statistics of the simulations already run.
+ * @return bool, where True indicates that the precision was reached and False otherwise (always False without --ci-half-width).
+*/
+static bool is_precision_reached(Sample_Statistics statistics)
+{
+    if(cli_args.ci_half_width <= 0 || statistics.num_samples < cli_args.min_simulations)
+        return false;
+
+    return calculate_confidence_half_width(statistics) <= cli_args.ci_half_width;
+}
+
+/**
+ * Verifies if the active simulation must be interrupted, since it reached the maximum number of timesteps, its pedestrians
+ * didn't move or leave for stall_limit consecutive timesteps or they can never move again.
+ *
+ * @param number_timesteps Number of timesteps already run by the active simulation.
+ * @return bool, where True indicates that the simulation must be interrupted and False otherwise.
+*/
+static bool is_simulation_interrupted(int number_timesteps)
+{
+    bool is_interrupted = (cli_args.max_timesteps > 0 && number_timesteps >= cli_args.max_timesteps) ||
+                          (cli_args.stall_limit > 0 && pedestrian_set.num_stalled_timesteps >= cli_args.stall_limit) ||
+                          is_environment_deadlocked();
+
+    if(is_interrupted && cli_args.show_debug_information)
+        printf("Simulation interrupted after %d timesteps.\n", number_timesteps);
+
+    return is_interrupted;
+}
+
+/**
+ * Writes the output of a simulation set, kept in memory, to the output file and memoizes it for the later simulation sets with the same exits.
+ *
+ * @param output_file
+ * @param set_output_file Memory stream where the output of the simulation set was written. Closed by this function.
+ * @param set_output Buffer of the memory stream, owned by the memoized simulation set afterwards.
+ * @param set_output_size Size of the buffer of the memory stream.
+ * @param status Status returned by calculate_final_floor_field for the simulation set.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status store_simulation_set_output(FILE *output_file, FILE *set_output_file, char **set_output, size_t *set_output_size, Function_Status status)
+{
+    fclose(set_output_file); // Updates the buffer and its size.
+
+    if(fwrite(*set_output, 1, *set_output_size, output_file) != *set_output_size)
+    {
+        fprintf(stderr, "Failure in the writing of the output of a simulation set.\n");
+        free(*set_output);
+        return FAILURE;
+    }
+
+    return memoize_simulation_set(*set_output, *set_output_size, status);
+}
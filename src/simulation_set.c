@@ -0,0 +1,500 @@
+/*
+   File: simulation_set.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module implements the index of the simulation sets described by the auxiliary file. The file is parsed a single
+                time, and the coordinates of the exits of every simulation set are stored in contiguous arrays, allowing any simulation
+                set to be loaded directly by its index. With --combine-exits, the simulation sets are instead the combinations of the
+                exits of the file, generated from their index when loaded.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<stdbool.h>
+#include<ctype.h>
+#include<limits.h>
+#include<unistd.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+
+#include"../headers/exit.h"
+#include"../headers/cli_processing.h"
+#include"../headers/simulation_set.h"
+#include"../headers/shared_resources.h"
+
+Simulation_Set_Index simulation_sets = {NULL, NULL, NULL, NULL, 0, 0, 0, 0};
+
+typedef struct{
+    const char *content;
+    size_t size;
+    size_t position; // Position of the next character to be parsed.
+}auxiliary_content;
+
+static Function_Status parse_simulation_sets(auxiliary_content *auxiliary);
+static Function_Status select_candidate_exits();
+static int compare_indexed_exits(const void *first, const void *second);
+static int compare_exit_cells(size_t first_exit, size_t second_exit);
+static long long int count_combinations(int n, int k);
+static void unrank_combination(long long int rank, int *combination);
+static Function_Status add_indexed_exit(size_t exit_index);
+static void skip_whitespace(auxiliary_content *auxiliary);
+static bool extract_coordinate(auxiliary_content *auxiliary, int *value);
+static Function_Status reserve_index_space(void **array, size_t *capacity, size_t required, size_t element_size);
+
+/**
+ * Parses the whole auxiliary file, storing the exits of every simulation set in the simulation_sets index.
+ *
+ * @note A simulation set not terminated by a period at the end of the file is still considered, as its exits were already provided.
+ *
+ * @param auxiliary_file File where the simulation sets are stored.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status load_simulation_set_index(FILE *auxiliary_file)
+{
+    if(auxiliary_file == NULL)
+        return FAILURE;
+
+    struct stat file_status;
+    if(fstat(fileno(auxiliary_file), &file_status) == -1)
+    {
+        fprintf(stderr, "Error while reading the auxiliary file.\n");
+        return FAILURE;
+    }
+
+    auxiliary_content auxiliary = {NULL, 0, 0};
+    if(file_status.st_size > 0) // Empty files can't be mapped and have no simulation sets.
+    {
+        void *content = mmap(NULL, file_status.st_size, PROT_READ, MAP_PRIVATE, fileno(auxiliary_file), 0);
+        if(content == MAP_FAILED)
+        {
+            fprintf(stderr, "Error while reading the auxiliary file.\n");
+            return FAILURE;
+        }
+
+        madvise(content, file_status.st_size, MADV_SEQUENTIAL);
+
+        auxiliary.content = content;
+        auxiliary.size = file_status.st_size;
+    }
+
+    Function_Status returned_status = parse_simulation_sets(&auxiliary);
+
+    if(auxiliary.size > 0)
+        munmap((void *) auxiliary.content, auxiliary.size);
+
+    if(returned_status == SUCCESS && cli_args.exit_combination_size > 0)
+        returned_status = select_candidate_exits();
+
+    return returned_status;
+}
+
+/**
+ * Adds the exits of the simulation set with the given index to the exits_set.
+ *
+ * @param set_index Index of the simulation set, in the order they appear in the auxiliary file or, with --combine-exits,
+ * in the lexicographic order of the combinations.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status load_simulation_set(int set_index)
+{
+    if(set_index < 0 || set_index >= simulation_sets.num_sets)
+    {
+        fprintf(stderr, "The simulation set %d doesn't exist in the auxiliary file.\n", set_index);
+        return FAILURE;
+    }
+
+    if(cli_args.exit_combination_size == 0)
+    {
+        for(size_t exit_index = simulation_sets.set_starts[set_index]; exit_index < simulation_sets.set_starts[set_index + 1]; exit_index++)
+        {
+            if(add_indexed_exit(exit_index) == FAILURE)
+                return FAILURE;
+        }
+
+        return SUCCESS;
+    }
+
+    int *combination = malloc(sizeof(int) * cli_args.exit_combination_size);
+    if(combination == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of an exit combination.\n");
+        return FAILURE;
+    }
+
+    unrank_combination(set_index, combination);
+
+    Function_Status returned_status = SUCCESS;
+    for(int position = 0; position < cli_args.exit_combination_size && returned_status == SUCCESS; position++)
+    {
+        if(position > 0 && combination[position] == combination[position - 1])
+            continue; // A repeated exit appears only once.
+
+        returned_status = add_indexed_exit(simulation_sets.candidate_exits[combination[position]]);
+    }
+
+    free(combination);
+
+    return returned_status;
+}
+
+/**
+ * Deallocates the arrays of the simulation_sets index.
+*/
+void deallocate_simulation_set_index()
+{
+    free(simulation_sets.cells);
+    free(simulation_sets.exit_starts);
+    free(simulation_sets.set_starts);
+    free(simulation_sets.candidate_exits);
+
+    simulation_sets = (Simulation_Set_Index) {NULL, NULL, NULL, NULL, 0, 0, 0, 0};
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Parses every simulation set of the auxiliary content. Each exit cell is given by a pair of coordinates followed by a symbol:
+ * '+' for an expansion of the current exit, ',' for a new exit and '.' for the end of the simulation set.
+ *
+ * @param auxiliary The content of the auxiliary file.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status parse_simulation_sets(auxiliary_content *auxiliary)
+{
+    size_t cells_capacity = 0, exits_capacity = 0, sets_capacity = 0;
+    bool new_exit = true; // True for a new exit, False for an expansion over the last new exit.
+    bool is_set_open = false; // Whether the current simulation set already has exits.
+
+    if(reserve_index_space((void **) &simulation_sets.set_starts, &sets_capacity, 1, sizeof(size_t)) == FAILURE ||
+       reserve_index_space((void **) &simulation_sets.exit_starts, &exits_capacity, 1, sizeof(size_t)) == FAILURE)
+        return FAILURE;
+
+    simulation_sets.set_starts[0] = 0;
+    simulation_sets.exit_starts[0] = 0;
+
+    while(1)
+    {
+        Location coordinates;
+
+        skip_whitespace(auxiliary);
+        if(auxiliary->position == auxiliary->size)
+            break; // All simulation sets were processed.
+
+        if( ! extract_coordinate(auxiliary, &coordinates.lin) || ! extract_coordinate(auxiliary, &coordinates.col))
+        {
+            fprintf(stderr, "Failure while reading the auxiliary file for exit coordinates. Verify if the syntax is being correctly followed.\n");
+            return FAILURE;
+        }
+
+        skip_whitespace(auxiliary);
+        if(auxiliary->position == auxiliary->size)
+        {
+            fprintf(stderr, "Failure while reading the auxiliary file for exit coordinates. Verify if the syntax is being correctly followed.\n");
+            return FAILURE;
+        }
+        char read_char = auxiliary->content[auxiliary->position++];
+
+        if(reserve_index_space((void **) &simulation_sets.cells, &cells_capacity, simulation_sets.num_cells + 1, sizeof(Location)) == FAILURE)
+            return FAILURE;
+
+        if(new_exit == true)
+        {
+            if(reserve_index_space((void **) &simulation_sets.exit_starts, &exits_capacity, simulation_sets.num_exits + 2, sizeof(size_t)) == FAILURE)
+                return FAILURE;
+
+            simulation_sets.num_exits++;
+        }
+
+        simulation_sets.cells[simulation_sets.num_cells++] = coordinates;
+        simulation_sets.exit_starts[simulation_sets.num_exits] = simulation_sets.num_cells;
+        is_set_open = true;
+
+        if(read_char == '+')
+            new_exit = false;
+        else if(read_char == ',')
+            new_exit = true;
+        else if(read_char == '.')
+        {
+            new_exit = true;
+            is_set_open = false;
+
+            if(reserve_index_space((void **) &simulation_sets.set_starts, &sets_capacity, simulation_sets.num_sets + 2, sizeof(size_t)) == FAILURE)
+                return FAILURE;
+
+            simulation_sets.set_starts[++simulation_sets.num_sets] = simulation_sets.num_exits;
+        }
+        else
+        {
+            fprintf(stderr, "Unknow symbol in the auxiliary file.\n");
+            return FAILURE;
+        }
+    }
+
+    if(is_set_open)
+    {
+        if(reserve_index_space((void **) &simulation_sets.set_starts, &sets_capacity, simulation_sets.num_sets + 2, sizeof(size_t)) == FAILURE)
+            return FAILURE;
+
+        simulation_sets.set_starts[++simulation_sets.num_sets] = simulation_sets.num_exits;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Selects, as candidates for the combinations of --combine-exits, the distinct exits of the auxiliary file, in the order they first
+ * appear, and determines the number of combinations.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status select_candidate_exits()
+{
+    size_t *sorted_exits = malloc(sizeof(size_t) * (simulation_sets.num_exits > 0 ? simulation_sets.num_exits : 1));
+    bool *is_repeated = calloc(simulation_sets.num_exits > 0 ? simulation_sets.num_exits : 1, sizeof(bool));
+    simulation_sets.candidate_exits = malloc(sizeof(size_t) * (simulation_sets.num_exits > 0 ? simulation_sets.num_exits : 1));
+    if(sorted_exits == NULL || is_repeated == NULL || simulation_sets.candidate_exits == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of the candidate exits.\n");
+        free(sorted_exits);
+        free(is_repeated);
+        return FAILURE;
+    }
+
+    for(size_t exit_index = 0; exit_index < simulation_sets.num_exits; exit_index++)
+        sorted_exits[exit_index] = exit_index;
+
+    // Equal exits become adjacent, with the first to appear in the file before its repetitions.
+    qsort(sorted_exits, simulation_sets.num_exits, sizeof(size_t), compare_indexed_exits);
+    for(size_t position = 1; position < simulation_sets.num_exits; position++)
+    {
+        if(compare_exit_cells(sorted_exits[position - 1], sorted_exits[position]) == 0)
+            is_repeated[sorted_exits[position]] = true;
+    }
+
+    simulation_sets.num_candidates = 0;
+    for(size_t exit_index = 0; exit_index < simulation_sets.num_exits; exit_index++)
+    {
+        if(! is_repeated[exit_index])
+            simulation_sets.candidate_exits[simulation_sets.num_candidates++] = exit_index;
+    }
+
+    free(sorted_exits);
+    free(is_repeated);
+
+    int n = simulation_sets.num_candidates, k = cli_args.exit_combination_size;
+    if(! cli_args.combination_with_repetition && k > n)
+    {
+        fprintf(stderr, "The number of exits in each combination (%d) is greater than the number of distinct exits in the auxiliary file (%d).\n", k, n);
+        return FAILURE;
+    }
+
+    long long int num_combinations = cli_args.combination_with_repetition ? count_combinations(n + k - 1, k) : count_combinations(n, k);
+    if(num_combinations < 0)
+    {
+        fprintf(stderr, "The number of combinations of %d exits among %d exits exceeds the limit of %d simulation sets.\n", k, n, INT_MAX);
+        return FAILURE;
+    }
+
+    simulation_sets.num_sets = (int) num_combinations;
+
+    return SUCCESS;
+}
+
+/**
+ * Compares two exits of the index, used with qsort. Equal exits are ordered by their position in the auxiliary file.
+ *
+ * @param first Pointer to the index, in exit_starts, of the first exit.
+ * @param second Pointer to the index, in exit_starts, of the second exit.
+ * @return An integer less than or greater than zero if the first exit is ordered before or after the second one.
+*/
+static int compare_indexed_exits(const void *first, const void *second)
+{
+    size_t first_exit = *(const size_t *) first, second_exit = *(const size_t *) second;
+
+    int comparison = compare_exit_cells(first_exit, second_exit);
+    if(comparison != 0)
+        return comparison;
+
+    return (first_exit > second_exit) - (first_exit < second_exit);
+}
+
+/**
+ * Compares the cells of two exits of the index.
+ *
+ * @note Used only to group equal exits, since the resulting order between different exits has no meaning.
+ *
+ * @param first_exit Index, in exit_starts, of the first exit.
+ * @param second_exit Index, in exit_starts, of the second exit.
+ * @return Zero if both exits have the same cells, in the same order, or a non-zero integer otherwise.
+*/
+static int compare_exit_cells(size_t first_exit, size_t second_exit)
+{
+    size_t first_width = simulation_sets.exit_starts[first_exit + 1] - simulation_sets.exit_starts[first_exit];
+    size_t second_width = simulation_sets.exit_starts[second_exit + 1] - simulation_sets.exit_starts[second_exit];
+
+    if(first_width != second_width)
+        return first_width < second_width ? -1 : 1;
+
+    return memcmp(&simulation_sets.cells[simulation_sets.exit_starts[first_exit]], &simulation_sets.cells[simulation_sets.exit_starts[second_exit]],
+                  sizeof(Location) * first_width);
+}
+
+/**
+ * Calculates the binomial coefficient C(n, k).
+ *
+ * @param n Number of elements.
+ * @param k Number of chosen elements.
+ * @return The number of combinations, 0 if k is negative or greater than n, or -1 if it exceeds INT_MAX.
+*/
+static long long int count_combinations(int n, int k)
+{
+    if(k < 0 || k > n)
+        return 0;
+
+    if(k > n - k)
+        k = n - k;
+
+    long long int num_combinations = 1;
+    for(int i = 1; i <= k; i++)
+    {
+        num_combinations = num_combinations * (n - k + i) / i; // Always C(n - k + i, i), an integer.
+        if(num_combinations > INT_MAX)
+            return -1;
+    }
+
+    return num_combinations;
+}
+
+/**
+ * Determines the combination of candidate exits at the given position of the lexicographic order. The candidates of each combination
+ * are strictly increasing or, with repetition, non-decreasing.
+ *
+ * @param rank Position of the combination, smaller than the number of combinations.
+ * @param combination Array, with space for cli_args.exit_combination_size candidates, where the combination will be stored.
+*/
+static void unrank_combination(long long int rank, int *combination)
+{
+    int n = simulation_sets.num_candidates, k = cli_args.exit_combination_size;
+    int candidate = 0;
+
+    for(int position = 0; position < k; position++)
+    {
+        while(1)
+        {
+            int remaining = k - position - 1; // Positions after the current one.
+
+            // Combinations that begin, from the current position, with the current candidate.
+            long long int num_combinations = cli_args.combination_with_repetition ? count_combinations(n - candidate + remaining - 1, remaining) 
+                                                                                  : count_combinations(n - candidate - 1, remaining);
+            if(rank < num_combinations)
+                break;
+
+            rank -= num_combinations;
+            candidate++;
+        }
+
+        combination[position] = candidate;
+        if(! cli_args.combination_with_repetition)
+            candidate++;
+    }
+}
+
+/**
+ * Adds the exit with the given index to the exits_set.
+ *
+ * @param exit_index Index of the exit in exit_starts.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status add_indexed_exit(size_t exit_index)
+{
+    size_t first_cell = simulation_sets.exit_starts[exit_index];
+
+    if(add_new_exit(simulation_sets.cells[first_cell]) == FAILURE)
+        return FAILURE;
+
+    Exit new_exit = exits_set.list[exits_set.num_exits - 1];
+    for(size_t cell_index = first_cell + 1; cell_index < simulation_sets.exit_starts[exit_index + 1]; cell_index++)
+    {
+        if(expand_exit(new_exit, simulation_sets.cells[cell_index]) == FAILURE)
+            return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Advances the auxiliary content past any whitespace.
+ *
+ * @param auxiliary The content of the auxiliary file.
+*/
+static void skip_whitespace(auxiliary_content *auxiliary)
+{
+    while(auxiliary->position < auxiliary->size && isspace((unsigned char) auxiliary->content[auxiliary->position]))
+        auxiliary->position++;
+}
+
+/**
+ * Extracts an optionally signed decimal integer, preceded by any whitespace, from the auxiliary content.
+ *
+ * @param auxiliary The content of the auxiliary file.
+ * @param value Pointer to the integer where the extracted value will be stored.
+ * @return bool, where True indicates that an integer was extracted and False otherwise.
+*/
+static bool extract_coordinate(auxiliary_content *auxiliary, int *value)
+{
+    skip_whitespace(auxiliary);
+
+    bool is_negative = false;
+    if(auxiliary->position < auxiliary->size && (auxiliary->content[auxiliary->position] == '-' || auxiliary->content[auxiliary->position] == '+'))
+        is_negative = auxiliary->content[auxiliary->position++] == '-';
+
+    size_t first_digit = auxiliary->position;
+    long long int extracted_value = 0;
+    while(auxiliary->position < auxiliary->size && isdigit((unsigned char) auxiliary->content[auxiliary->position]))
+    {
+        if(extracted_value <= INT_MAX)
+            extracted_value = extracted_value * 10 + (auxiliary->content[auxiliary->position] - '0');
+        auxiliary->position++;
+    }
+
+    if(auxiliary->position == first_digit || extracted_value > INT_MAX)
+        return false;
+
+    *value = is_negative ? (int) -extracted_value : (int) extracted_value;
+
+    return true;
+}
+
+/**
+ * Guarantees that an array of the index has space for, at least, the required number of elements, doubling its capacity when needed.
+ *
+ * @param array Pointer to the array.
+ * @param capacity Pointer to the current capacity of the array, in elements.
+ * @param required Number of elements the array must be able to hold.
+ * @param element_size Size, in bytes, of each element.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status reserve_index_space(void **array, size_t *capacity, size_t required, size_t element_size)
+{
+    if(required <= *capacity)
+        return SUCCESS;
+
+    size_t new_capacity = *capacity > 0 ? *capacity : 64;
+    while(new_capacity < required)
+        new_capacity *= 2;
+
+    void *new_array = realloc(*array, new_capacity * element_size);
+    if(new_array == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of the simulation sets index.\n");
+        return FAILURE;
+    }
+
+    *array = new_array;
+    *capacity = new_capacity;
+
+    return SUCCESS;
+}
@@ -0,0 +1,90 @@
+/*
+   File: statistics.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-19
+   Description: This module contains the running statistics of the number of timesteps of the simulations, used to decide how many
+                simulations of a simulation set are needed to estimate its mean evacuation time with a given precision.
+*/
+
+#include<math.h>
+
+#include"../headers/statistics.h"
+
+#define NORMAL_QUANTILE_95 1.959964 // Quantile of the standard normal distribution for a two-sided 95% confidence interval.
+
+// Quantiles of the Student's t distribution for a two-sided 95% confidence interval, indexed by the degrees of freedom - 1.
+static const double student_t_quantiles_95[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                                2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                                2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+
+static double get_student_t_quantile(int degrees_of_freedom);
+
+/**
+ * Adds a sample to the running statistics.
+ *
+ * @param statistics Pointer to the statistics to be updated.
+ * @param value Value of the sample.
+*/
+void add_sample(Sample_Statistics *statistics, double value)
+{
+    statistics->num_samples++;
+
+    double deviation = value - statistics->mean;
+    statistics->mean += deviation / statistics->num_samples;
+    statistics->sum_squared_deviations += deviation * (value - statistics->mean);
+}
+
+/**
+ * Calculates the sample standard deviation.
+ *
+ * @param statistics Statistics of the samples.
+ * @return The standard deviation, or 0 if there are less than two samples.
+*/
+double calculate_standard_deviation(Sample_Statistics statistics)
+{
+    if(statistics.num_samples < 2)
+        return 0;
+
+    return sqrt(statistics.sum_squared_deviations / (statistics.num_samples - 1));
+}
+
+/**
+ * Calculates the half-width of the 95% confidence interval of the mean, based on the Student's t distribution.
+ *
+ * @param statistics Statistics of the samples.
+ * @return The half-width of the confidence interval, or INFINITY if there are less than two samples.
+*/
+double calculate_confidence_half_width(Sample_Statistics statistics)
+{
+    if(statistics.num_samples < 2)
+        return INFINITY;
+
+    return get_student_t_quantile(statistics.num_samples - 1) * calculate_standard_deviation(statistics) / sqrt(statistics.num_samples);
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Determines the quantile of the Student's t distribution for a two-sided 95% confidence interval.
+ *
+ * @note Above the tabulated degrees of freedom, the quantile is approximated by the first two terms of its expansion around
+ * the normal quantile (Cornish-Fisher), which differ from the exact value by less than 0.001.
+ *
+ * @param degrees_of_freedom Degrees of freedom, at least 1.
+ * @return The quantile.
+*/
+static double get_student_t_quantile(int degrees_of_freedom)
+{
+    int num_quantiles = sizeof(student_t_quantiles_95) / sizeof(double);
+
+    if(degrees_of_freedom <= num_quantiles)
+        return student_t_quantiles_95[degrees_of_freedom - 1];
+
+    double z = NORMAL_QUANTILE_95;
+    double first_term = (pow(z, 3) + z) / (4.0 * degrees_of_freedom);
+    double second_term = (5 * pow(z, 5) + 16 * pow(z, 3) + 3 * z) / (96.0 * degrees_of_freedom * degrees_of_freedom);
+
+    return z + first_term + second_term;
+}
@@ -0,0 +1,449 @@
+/*
+   File: sweep.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-19
+   Description: This module implements the parameter sweeps, which run the simulation sets for every combination of the values
+                given to some of the parameters (number of pedestrians, diagonal value, seed and toggle options) in a single
+                execution. The environment is loaded once, and the floor fields of the exits are kept between the sweep points
+                that share the parameters they depend on.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<stdbool.h>
+
+#include"../headers/exit.h"
+#include"../headers/pedestrian.h"
+#include"../headers/sweep.h"
+#include"../headers/simulation.h"
+#include"../headers/connectivity.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+#define SWEEP_VALUE_LENGTH 16
+#define MAX_SWEEP_VALUES 10000
+
+enum Sweep_Parameter{
+    SWEEP_DIAGONAL,
+    SWEEP_AVOID_CORNER_MOVEMENT,
+    SWEEP_VARAS_FIG7,
+    SWEEP_PEDESTRIANS,
+    SWEEP_SEED,
+    SWEEP_IMMEDIATE_EXIT,
+    SWEEP_ALWAYS_TO_LOWEST,
+    SWEEP_ALLOW_X_MOVEMENT,
+    NUM_SWEEP_PARAMETERS
+};
+
+typedef struct{
+    const char *name; // As given to --sweep.
+    bool is_toggle; // Takes the values 0 and 1.
+    bool affects_floor_fields; // The floor fields of the exits are calculated again when it changes.
+    bool affects_components; // The connected components of the environment are labeled again when it changes.
+    int num_values; // 0 if the parameter isn't swept.
+    char (*values)[SWEEP_VALUE_LENGTH];
+}sweep_parameter;
+
+// In the order of the nested loops of the sweep, from the outermost, so that the floor fields change as rarely as possible.
+static sweep_parameter sweep_parameters[NUM_SWEEP_PARAMETERS] = {
+    {"diagonal", false, true, false, 0, NULL},
+    {"avoid-corner-movement", true, true, true, 0, NULL},
+    {"varas-fig7", true, false, true, 0, NULL},
+    {"p", false, false, false, 0, NULL},
+    {"seed", false, false, false, 0, NULL},
+    {"immediate-exit", true, false, false, 0, NULL},
+    {"always-to-lowest", true, false, false, 0, NULL},
+    {"allow-x-movement", true, false, false, 0, NULL},
+};
+
+static Function_Status add_sweep_parameter(const char *specification);
+static Function_Status add_sweep_value(sweep_parameter *parameter, const char *value);
+static Function_Status add_sweep_range(sweep_parameter *parameter, const char *range);
+static bool is_valid_sweep_value(enum Sweep_Parameter parameter_index, const char *value);
+static void apply_sweep_value(enum Sweep_Parameter parameter_index, const char *value);
+static bool advance_sweep_point(int *value_indexes, bool *is_changed);
+static void print_sweep_point(FILE *output_file, int *value_indexes);
+
+/**
+ * Parses the parameters given to --sweep, replacing those of a previous run of the batch file.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status load_sweep_parameters()
+{
+    deallocate_sweep_parameters();
+
+    char specifications[sizeof(cli_args.sweep_specifications)];
+    strcpy(specifications, cli_args.sweep_specifications);
+
+    char *save_pointer = NULL;
+    for(char *specification = strtok_r(specifications, " ", &save_pointer); specification != NULL; specification = strtok_r(NULL, " ", &save_pointer))
+    {
+        if(add_sweep_parameter(specification) == FAILURE)
+            return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Verifies if any parameter is swept.
+ *
+ * @return bool, where True indicates that --sweep was given and False otherwise.
+*/
+bool is_sweep_active()
+{
+    for(int parameter_index = 0; parameter_index < NUM_SWEEP_PARAMETERS; parameter_index++)
+    {
+        if(sweep_parameters[parameter_index].num_values > 0)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * Runs the simulation sets for every combination of the values of the swept parameters, writing a "Sweep point" line, with the
+ * values of the swept parameters, before the output of each combination.
+ *
+ * @note Every sweep point starts from the seed given by --seed (unless the seed is swept), so its output is the same as that of a
+ * separate execution with its parameters. The floor fields of the exits are cached, as with --floor-field-cache, and only
+ * discarded when a parameter they depend on changes.
+ *
+ * @param output_file Stream where the output data will be written.
+ * @param num_sets Number of simulation sets, where the origins that use static exits have a single one.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status run_sweep(FILE *output_file, int num_sets)
+{
+    if(sweep_parameters[SWEEP_PEDESTRIANS].num_values > 0 && origin_uses_static_pedestrians() == true)
+    {
+        fprintf(stderr, "The number of pedestrians can only be swept when they are randomly placed (--env-load-method 1, 2 or 5).\n");
+        return FAILURE;
+    }
+
+    int first_seed = cli_args.seed;
+    cli_args.use_floor_field_cache = true;
+
+    int value_indexes[NUM_SWEEP_PARAMETERS] = {0};
+    bool is_changed[NUM_SWEEP_PARAMETERS] = {false};
+    bool is_first_point = true;
+
+    do
+    {
+        bool are_floor_fields_outdated = false;
+        bool are_components_outdated = false;
+
+        cli_args.seed = first_seed;
+        for(int parameter_index = 0; parameter_index < NUM_SWEEP_PARAMETERS; parameter_index++)
+        {
+            sweep_parameter *parameter = &sweep_parameters[parameter_index];
+            if(parameter->num_values == 0)
+                continue;
+
+            apply_sweep_value(parameter_index, parameter->values[value_indexes[parameter_index]]);
+
+            are_floor_fields_outdated |= is_changed[parameter_index] && parameter->affects_floor_fields;
+            are_components_outdated |= is_changed[parameter_index] && parameter->affects_components;
+        }
+
+        if(! is_first_point && origin_uses_static_exits() == true)
+            deallocate_floor_fields(); // The final floor field is merged again, from the cache if the floor fields are up to date.
+
+        if(! is_first_point && origin_uses_static_pedestrians() == true)
+            count_pedestrians_in_heatmap(); // As when they were loaded, before the first sweep point.
+
+        if(are_floor_fields_outdated)
+            deallocate_floor_field_cache();
+
+        if(are_components_outdated)
+        {
+            deallocate_environment_components();
+            if(label_environment_components() == FAILURE)
+                return FAILURE;
+        }
+
+        print_sweep_point(output_file, value_indexes);
+
+        if(run_simulation_sets(output_file, num_sets) == FAILURE)
+            return FAILURE;
+
+        is_first_point = false;
+
+    }while(advance_sweep_point(value_indexes, is_changed));
+
+    return SUCCESS;
+}
+
+/**
+ * Deallocates the values of the swept parameters.
+*/
+void deallocate_sweep_parameters()
+{
+    for(int parameter_index = 0; parameter_index < NUM_SWEEP_PARAMETERS; parameter_index++)
+    {
+        free(sweep_parameters[parameter_index].values);
+        sweep_parameters[parameter_index].values = NULL;
+        sweep_parameters[parameter_index].num_values = 0;
+    }
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Adds a parameter to the sweep, with the values it takes, as given to --sweep.
+ *
+ * @param specification The name of the parameter followed by a colon and a comma separated list of its values (e.g. p:50,100),
+ * where the integer parameters also accept inclusive ranges (e.g. seed:0-9).
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status add_sweep_parameter(const char *specification)
+{
+    const char *separator = strchr(specification, ':');
+    if(separator == NULL || separator[1] == '\0')
+    {
+        fprintf(stderr, "A sweep must be given as PARAMETER:VALUES, but %s was given.\n", specification);
+        return FAILURE;
+    }
+
+    sweep_parameter *parameter = NULL;
+    for(int parameter_index = 0; parameter_index < NUM_SWEEP_PARAMETERS; parameter_index++)
+    {
+        size_t name_length = strlen(sweep_parameters[parameter_index].name);
+        if(name_length == (size_t) (separator - specification) && strncmp(specification, sweep_parameters[parameter_index].name, name_length) == 0)
+            parameter = &sweep_parameters[parameter_index];
+    }
+
+    if(parameter == NULL)
+    {
+        fprintf(stderr, "Unknown sweep parameter in %s. The parameters that can be swept are p, diagonal, seed, immediate-exit, always-to-lowest, "
+                        "avoid-corner-movement, allow-x-movement and varas-fig7.\n", specification);
+        return FAILURE;
+    }
+
+    if(parameter->num_values > 0)
+    {
+        fprintf(stderr, "The sweep parameter %s was given more than once.\n", parameter->name);
+        return FAILURE;
+    }
+
+    char values[strlen(separator + 1) + 1];
+    strcpy(values, separator + 1);
+
+    for(char *value = strtok(values, ","); value != NULL; value = strtok(NULL, ","))
+    {
+        enum Sweep_Parameter parameter_index = parameter - sweep_parameters;
+        bool is_range = (parameter_index == SWEEP_PEDESTRIANS || parameter_index == SWEEP_SEED) && strchr(value + 1, '-') != NULL;
+
+        Function_Status returned_status = is_range ? add_sweep_range(parameter, value) : add_sweep_value(parameter, value);
+        if(returned_status == FAILURE)
+            return FAILURE;
+    }
+
+    if(parameter->num_values == 0)
+    {
+        fprintf(stderr, "No value was given to the sweep parameter %s.\n", parameter->name);
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Adds a value to a swept parameter, after verifying it.
+ *
+ * @param parameter The swept parameter.
+ * @param value The value, as given to --sweep.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status add_sweep_value(sweep_parameter *parameter, const char *value)
+{
+    if(! is_valid_sweep_value(parameter - sweep_parameters, value))
+    {
+        fprintf(stderr, "Invalid value (%s) for the sweep parameter %s.\n", value, parameter->name);
+        return FAILURE;
+    }
+
+    if(parameter->num_values == MAX_SWEEP_VALUES)
+    {
+        fprintf(stderr, "The sweep parameter %s can't take more than %d values.\n", parameter->name, MAX_SWEEP_VALUES);
+        return FAILURE;
+    }
+
+    char (*values)[SWEEP_VALUE_LENGTH] = realloc(parameter->values, sizeof(*values) * (parameter->num_values + 1));
+    if(values == NULL)
+    {
+        fprintf(stderr, "Failure in the realloc of the values of the sweep parameter %s.\n", parameter->name);
+        return FAILURE;
+    }
+
+    parameter->values = values;
+    strcpy(parameter->values[parameter->num_values++], value);
+
+    return SUCCESS;
+}
+
+/**
+ * Adds every value of an inclusive range of integers to a swept parameter.
+ *
+ * @param parameter The swept parameter, which takes integer values.
+ * @param range The range, written as FIRST-LAST.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status add_sweep_range(sweep_parameter *parameter, const char *range)
+{
+    char *end = NULL;
+    long first_value = strtol(range, &end, 10);
+    if(end == range || *end != '-')
+    {
+        fprintf(stderr, "Invalid range (%s) for the sweep parameter %s.\n", range, parameter->name);
+        return FAILURE;
+    }
+
+    const char *last_text = end + 1;
+    long last_value = strtol(last_text, &end, 10);
+    if(end == last_text || *end != '\0' || last_value < first_value || last_value - first_value >= MAX_SWEEP_VALUES)
+    {
+        fprintf(stderr, "Invalid range (%s) for the sweep parameter %s.\n", range, parameter->name);
+        return FAILURE;
+    }
+
+    for(long value = first_value; value <= last_value; value++)
+    {
+        char value_text[SWEEP_VALUE_LENGTH];
+        snprintf(value_text, SWEEP_VALUE_LENGTH, "%ld", value);
+
+        if(add_sweep_value(parameter, value_text) == FAILURE)
+            return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Verifies if a value is valid for a swept parameter, following the same rules of the corresponding option.
+ *
+ * @param parameter_index The swept parameter.
+ * @param value The value, as given to --sweep.
+ * @return bool, where True indicates that the value is valid and False otherwise.
+*/
+static bool is_valid_sweep_value(enum Sweep_Parameter parameter_index, const char *value)
+{
+    if(strlen(value) == 0 || strlen(value) >= SWEEP_VALUE_LENGTH)
+        return false;
+
+    if(sweep_parameters[parameter_index].is_toggle)
+        return strcmp(value, "0") == 0 || strcmp(value, "1") == 0;
+
+    if(parameter_index == SWEEP_DIAGONAL)
+    {
+        int numerator, denominator;
+        return extract_diagonal_fraction(value, &numerator, &denominator) == SUCCESS;
+    }
+
+    char *end = NULL;
+    long integer_value = strtol(value, &end, 10);
+    if(*end != '\0' || integer_value > 1000000000)
+        return false;
+
+    return parameter_index == SWEEP_PEDESTRIANS ? integer_value > 0 : integer_value >= 0;
+}
+
+/**
+ * Sets the parameter corresponding to a swept parameter in the cli_args.
+ *
+ * @param parameter_index The swept parameter.
+ * @param value The value, already verified.
+*/
+static void apply_sweep_value(enum Sweep_Parameter parameter_index, const char *value)
+{
+    bool is_on = strcmp(value, "1") == 0;
+
+    switch(parameter_index)
+    {
+        case SWEEP_DIAGONAL:
+            cli_args.diagonal = atof(value);
+            extract_diagonal_fraction(value, &cli_args.diagonal_numerator, &cli_args.diagonal_denominator);
+            break;
+        case SWEEP_AVOID_CORNER_MOVEMENT:
+            cli_args.prevent_corner_crossing = is_on;
+            break;
+        case SWEEP_VARAS_FIG7:
+            cli_args.varas_fig7 = is_on;
+            break;
+        case SWEEP_PEDESTRIANS:
+            cli_args.total_num_pedestrians = atoi(value);
+            break;
+        case SWEEP_SEED:
+            cli_args.seed = atoi(value);
+            break;
+        case SWEEP_IMMEDIATE_EXIT:
+            cli_args.immediate_exit = is_on;
+            break;
+        case SWEEP_ALWAYS_TO_LOWEST:
+            cli_args.always_move_to_lowest = is_on;
+            break;
+        case SWEEP_ALLOW_X_MOVEMENT:
+            cli_args.allow_X_movement = is_on;
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * Advances to the next sweep point, changing the value of the innermost swept parameter and, when its values are exhausted, of
+ * the parameters around it.
+ *
+ * @param value_indexes Index of the current value of each swept parameter.
+ * @param is_changed Array where the parameters whose value changed will be marked.
+ * @return bool, where True indicates that there is another sweep point and False that the sweep is finished.
+*/
+static bool advance_sweep_point(int *value_indexes, bool *is_changed)
+{
+    for(int parameter_index = 0; parameter_index < NUM_SWEEP_PARAMETERS; parameter_index++)
+        is_changed[parameter_index] = false;
+
+    for(int parameter_index = NUM_SWEEP_PARAMETERS - 1; parameter_index >= 0; parameter_index--)
+    {
+        if(sweep_parameters[parameter_index].num_values <= 1)
+            continue;
+
+        is_changed[parameter_index] = true;
+        value_indexes[parameter_index]++;
+        if(value_indexes[parameter_index] < sweep_parameters[parameter_index].num_values)
+            return true;
+
+        value_indexes[parameter_index] = 0;
+    }
+
+    return false;
+}
+
+/**
+ * Prints the values of the swept parameters at the current sweep point.
+ *
+ * @param output_file Stream where the sweep point will be written.
+ * @param value_indexes Index of the current value of each swept parameter.
+*/
+static void print_sweep_point(FILE *output_file, int *value_indexes)
+{
+    fprintf(output_file, "Sweep point:");
+
+    bool is_first = true;
+    for(int parameter_index = 0; parameter_index < NUM_SWEEP_PARAMETERS; parameter_index++)
+    {
+        sweep_parameter *parameter = &sweep_parameters[parameter_index];
+        if(parameter->num_values == 0)
+            continue;
+
+        fprintf(output_file, "%s %s=%s", is_first ? "" : ",", parameter->name, parameter->values[value_indexes[parameter_index]]);
+        is_first = false;
+    }
+
+    fprintf(output_file, ".\n");
+}
+
@@ -0,0 +1,209 @@
+/*
+   File: thread_pool.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module implements a pool of worker threads, created once, that runs groups of independent tasks in parallel.
+                The thread that submits a group of tasks also runs them, and waits until every task of the group is finished.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdbool.h>
+#include<pthread.h>
+
+#include"../headers/thread_pool.h"
+#include"../headers/shared_resources.h"
+
+typedef struct{
+    pthread_t *workers;
+    int num_workers; // Threads created by the pool, besides the thread that submits the tasks.
+    pthread_mutex_t lock;
+    pthread_cond_t tasks_available;
+    pthread_cond_t tasks_finished;
+    Parallel_Task task; // Function run for each task of the current group.
+    void *task_data;
+    int num_tasks;
+    int next_task; // Index of the next task of the group to be run.
+    int num_finished_tasks;
+    unsigned long int group_number; // Incremented for each group of tasks, so that workers recognize new groups.
+    bool is_shutting_down;
+}thread_pool_state;
+
+static thread_pool_state thread_pool = {NULL, 0, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER,
+                                        NULL, NULL, 0, 0, 0, 0, false};
+
+static _Thread_local bool is_running_task = false; // Whether the thread is running a task of the pool.
+
+static void *worker_routine(void *argument);
+static void run_available_tasks();
+
+/**
+ * Creates the thread pool.
+ *
+ * @param num_threads Total number of threads that run the tasks, including the thread that submits them. A single thread
+ * creates no workers, and the tasks are run sequentially.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status create_thread_pool(int num_threads)
+{
+    if(num_threads <= 1)
+        return SUCCESS;
+
+    thread_pool.workers = malloc(sizeof(pthread_t) * (num_threads - 1));
+    if(thread_pool.workers == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of the thread pool.\n");
+        return FAILURE;
+    }
+
+    for(int worker_index = 0; worker_index < num_threads - 1; worker_index++)
+    {
+        if(pthread_create(&thread_pool.workers[worker_index], NULL, worker_routine, NULL) != 0)
+        {
+            fprintf(stderr, "Failure in the creation of the worker thread %d of the thread pool.\n", worker_index);
+            destroy_thread_pool();
+            return FAILURE;
+        }
+
+        thread_pool.num_workers++;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Runs a group of tasks, in parallel when the thread pool is active, and waits until all of them are finished.
+ *
+ * @note Each task must only modify data that isn't accessed by other tasks of the group. Groups submitted from inside a task
+ * are run sequentially by the thread running that task.
+ *
+ * @param task Function called once for each task, with its index.
+ * @param task_data Data shared by every task of the group.
+ * @param num_tasks Number of tasks of the group.
+*/
+void run_parallel_tasks(Parallel_Task task, void *task_data, int num_tasks)
+{
+    if(thread_pool.num_workers == 0 || num_tasks <= 1 || is_running_task)
+    {
+        for(int task_index = 0; task_index < num_tasks; task_index++)
+            task(task_data, task_index);
+
+        return;
+    }
+
+    pthread_mutex_lock(&thread_pool.lock);
+    thread_pool.task = task;
+    thread_pool.task_data = task_data;
+    thread_pool.num_tasks = num_tasks;
+    thread_pool.next_task = 0;
+    thread_pool.num_finished_tasks = 0;
+    thread_pool.group_number++;
+    pthread_cond_broadcast(&thread_pool.tasks_available);
+
+    run_available_tasks();
+
+    while(thread_pool.num_finished_tasks < thread_pool.num_tasks)
+        pthread_cond_wait(&thread_pool.tasks_finished, &thread_pool.lock);
+
+    thread_pool.task = NULL;
+    thread_pool.task_data = NULL;
+    pthread_mutex_unlock(&thread_pool.lock);
+}
+
+/**
+ * Verifies if the thread pool has worker threads.
+ *
+ * @return bool, where True indicates that the tasks are run in parallel and False otherwise.
+*/
+bool is_thread_pool_active()
+{
+    return thread_pool.num_workers > 0;
+}
+
+/**
+ * Determines the number of threads that run the tasks, including the thread that submits them.
+ *
+ * @return The number of threads.
+*/
+int get_thread_pool_size()
+{
+    return thread_pool.num_workers + 1;
+}
+
+/**
+ * Finishes the worker threads and deallocates the thread pool.
+*/
+void destroy_thread_pool()
+{
+    if(thread_pool.workers == NULL)
+        return;
+
+    pthread_mutex_lock(&thread_pool.lock);
+    thread_pool.is_shutting_down = true;
+    pthread_cond_broadcast(&thread_pool.tasks_available);
+    pthread_mutex_unlock(&thread_pool.lock);
+
+    for(int worker_index = 0; worker_index < thread_pool.num_workers; worker_index++)
+        pthread_join(thread_pool.workers[worker_index], NULL);
+
+    free(thread_pool.workers);
+    thread_pool.workers = NULL;
+    thread_pool.num_workers = 0;
+    thread_pool.is_shutting_down = false;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Routine of each worker thread, which waits for groups of tasks and runs them until the pool is destroyed.
+ *
+ * @param argument Unused.
+ * @return NULL.
+*/
+static void *worker_routine(void *argument)
+{
+    unsigned long int last_group_number = 0;
+
+    pthread_mutex_lock(&thread_pool.lock);
+    while(1)
+    {
+        while(thread_pool.group_number == last_group_number && ! thread_pool.is_shutting_down)
+            pthread_cond_wait(&thread_pool.tasks_available, &thread_pool.lock);
+
+        if(thread_pool.is_shutting_down)
+            break;
+
+        last_group_number = thread_pool.group_number;
+        run_available_tasks();
+    }
+    pthread_mutex_unlock(&thread_pool.lock);
+
+    return NULL;
+}
+
+/**
+ * Runs tasks of the current group until none is left to be started.
+ *
+ * @note Must be called with the lock of the pool held, which is released while each task runs.
+*/
+static void run_available_tasks()
+{
+    while(thread_pool.next_task < thread_pool.num_tasks)
+    {
+        int task_index = thread_pool.next_task++;
+        Parallel_Task task = thread_pool.task;
+        void *task_data = thread_pool.task_data;
+
+        pthread_mutex_unlock(&thread_pool.lock);
+        is_running_task = true;
+        task(task_data, task_index);
+        is_running_task = false;
+        pthread_mutex_lock(&thread_pool.lock);
+
+        thread_pool.num_finished_tasks++;
+        if(thread_pool.num_finished_tasks == thread_pool.num_tasks)
+            pthread_cond_broadcast(&thread_pool.tasks_finished);
+    }
+}
@@ -0,0 +1,5 @@
+#!/bin/bash
+
+# Compares the memory layouts of the field grids on a large environment.
+# Usage: ./varas_benchmark.sh [SIDE] [PRECISION] [PEDESTRIANS] [TIMESTEPS]
+gcc -O2 -o build/grid_layout_benchmark.exe benchmark/grid_layout_benchmark.c src/grid.c src/cli_processing.c src/shared_resources.c -lm -Wall && ./build/grid_layout_benchmark.exe "$@"
@@ -0,0 +1,101 @@
+#!/bin/bash
+
+# Runs the regression tests of the simulator. Each test prints PASS or FAIL, and the script fails if any test fails.
+# Usage: ./varas_tests.sh
+
+# Prints the provided text in the given color.
+# $1 Sequence code of the chosen color.
+# $2 The string to be printed.
+print_in_color()
+{
+    echo -e "$1$2\033[0m"
+}
+
+# Records the result of a test.
+# $1 Name of the test.
+# $2 Exit status of the test, where 0 indicates success.
+report_test()
+{
+    if [ "$2" -eq 0 ]; then
+        print_in_color "\033[0;32m" "PASS $1"
+    else
+        print_in_color "\033[0;31m" "FAIL $1"
+        failed_tests=$((failed_tests + 1))
+    fi
+}
+
+# Runs the simulator, discarding the lines with the time at which each simulation set is finalized.
+run_varas()
+{
+    timeout 300 ./build/varas.exe "$@" 2>&1 | grep -v "finalized at"
+}
+
+# A corridor longer than WALL_VALUE cells, whose far cells must not be taken as walls, in every precision. Each precision must
+# print only the timesteps of its 2 simulations, none of them interrupted (-2).
+test_long_corridor()
+{
+    local results
+    for precision in 1 2 3 4; do
+        results=$(run_varas -m5 -l3 -c1100 -avaras_tests_corridor.txt -O2 -p1 -s2 --max-timesteps=5000 --field-precision=$precision | tail -n +4)
+        grep -qE -- "(^| )-2( |$)" <<< "$results" && return 1
+        [[ "$results" =~ ^[1-9][0-9]*\ [1-9][0-9]*\ $ ]] || return 1
+    done
+    return 0
+}
+
+# The largest corridor whose floor field values fit an integer with a diagonal of 6 decimal places, and the first one that doesn't.
+test_field_units_limit()
+{
+    run_varas -m5 -l3 -c715 -avaras_tests_corridor.txt -O2 -p1 -s1 --diagonal=1.000001 --field-precision=4 | grep -q "above the limit" && return 1
+    run_varas -m5 -l3 -c716 -avaras_tests_corridor.txt -O2 -p1 -s1 --diagonal=1.000001 | grep -q "above the limit" || return 1
+    return 0
+}
+
+# The spatial sorting only changes the order in which the pedestrians are processed, so the results are the same as without it.
+test_spatial_sort_results()
+{
+    for options in "-m5 -l40 -c60 -avaras_door_width.txt -O2 -p600 -s3" "-m5 -l40 -c60 -avaras_door_width.txt -O3 -p600 -s2 --allow-x-movement --always-to-lowest" \
+                   "-m3 -evaras_classroom_with_obstacles.txt -avaras_optimal_location-door_combination.txt -O2 -s2 --avoid-corner-movement"; do
+        unsorted_output=$(run_varas $options | tail -n +2)
+        for interval in 1 5; do
+            [ "$(run_varas $options --spatial-sort=$interval | tail -n +2)" == "$unsorted_output" ] || return 1
+        done
+    done
+    return 0
+}
+
+# The runs of a batch file share the environment, so each one must give the same output as a separate execution, whatever the
+# output format of the runs before it.
+test_batch_mixed_formats()
+{
+    local environment="-m3 -evaras_classroom_with_obstacles.txt -avaras_double_doors.txt"
+    local runs=("-O2 -s2" "-O3 -s2" "-O1 -s1" "-O3 -s1 --avoid-corner-movement" "-O2 -s2 --diagonal=1")
+    local batch_file=output/varas_tests/batch.txt
+
+    rm -rf output/varas_tests
+    mkdir -p output/varas_tests
+    for run_index in "${!runs[@]}"; do
+        echo "$environment ${runs[$run_index]} -ovaras_tests/batch_$run_index.txt" >> $batch_file
+        run_varas $environment ${runs[$run_index]} -ovaras_tests/separate_$run_index.txt > /dev/null
+    done
+    run_varas --batch=$batch_file > /dev/null
+
+    local returned_status=0
+    for run_index in "${!runs[@]}"; do
+        cmp -s <(tail -n +2 output/varas_tests/batch_$run_index.txt | grep -v "finalized at") \
+               <(tail -n +2 output/varas_tests/separate_$run_index.txt | grep -v "finalized at") || returned_status=1
+    done
+
+    rm -rf output/varas_tests
+    return $returned_status
+}
+
+gcc -o build/varas.exe src/*.c -lm -pthread -Wall || exit 1
+
+failed_tests=0
+for test_name in test_long_corridor test_field_units_limit test_spatial_sort_results test_batch_mixed_formats; do
+    $test_name
+    report_test "$test_name" $?
+done
+
+[ "$failed_tests" -eq 0 ]